@@ -0,0 +1,84 @@
+// backtest/exchange_sim.hpp
+#pragma once
+
+#include "backtest/timing_wheel.hpp"
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+#include "exchange/order_book.hpp"
+#include "strategy/quoter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nanomarket::backtest {
+
+// Discrete-event exchange simulation with modelled latencies, driven by a TimingWheel in logical
+// time. Nothing reads the wall clock, so a run is a pure function of tape, config and seed.
+//
+//   tape order     --(at its ts)-------------------------> matching engine
+//   participant    --(order_entry latency)---------------> matching engine
+//   matching engine: one server; each order occupies it for a `matching` latency sample and is
+//                    applied to the book when its service completes (FIFO, so queueing is modelled)
+//   matching engine --(market_data latency)--> participant: every trade print, a top-of-book
+//                                                tick after each tape order, private acks/rejects
+//
+// Each channel delivers in order: a sample never lets a message overtake the previous one on
+// the same channel. Participants are event-driven strategy::Quoter instances (the deterministic
+// counterpart of MarketMaker). A participant reacts to top-of-book ticks and keeps at most one
+// requote in flight: a tick that arrives while any of its orders is unacknowledged is ignored.
+// Risk is checked per participant at the exchange. Tape orders are the rest of the market and
+// bypass risk, as in the parameter sweep. With zero latencies and strictly increasing tape
+// timestamps, a single participant gets exactly the backtest::run_single result.
+
+// Latency distribution in nanoseconds: base + uniform [0, jitter], plus `spike_ns` with
+// probability spike_ppm / 1e6. Integer-only sampling keeps results identical across platforms.
+struct LatencyModel {
+    core::Timestamp base_ns = 0;
+    core::Timestamp jitter_ns = 0;
+    uint32_t spike_ppm = 0;
+    core::Timestamp spike_ns = 0;
+
+    core::Timestamp sample(uint64_t& rng) const noexcept;
+};
+
+struct ParticipantConfig {
+    strategy::Quoter::Settings quoter;
+    LatencyModel order_entry;   // participant -> matching engine
+    LatencyModel market_data;   // matching engine -> participant (public and private messages)
+};
+
+struct SimConfig {
+    exchange::OrderBook::Config book{1, 64, 1024, 10000};
+    LatencyModel matching;               // service time per order inside the engine
+    int64_t tape_time_scale = 1;         // nanoseconds per unit of the tape's ts column
+    uint64_t seed = 1;
+    size_t max_in_flight = 1u << 20;     // timing wheel pool size
+    // Risk limits applied to every participant (RiskEngine defaults unless overridden).
+    int64_t max_position = 100;
+    int64_t max_order_size = 50;
+    int64_t max_notional = 1000000;
+};
+
+struct SimStats {
+    uint64_t events = 0;            // wheel events processed
+    uint64_t tape_orders = 0;
+    uint64_t participant_orders = 0;
+    uint64_t rejects = 0;
+    uint64_t executions = 0;
+    uint64_t dropped = 0;           // events lost because the wheel pool was full
+    size_t peak_in_flight = 0;
+    core::Timestamp end_ns = 0;     // logical time of the last event
+    int64_t max_queue_ns = 0;       // longest wait for the matching engine
+};
+
+struct SimResult {
+    std::vector<strategy::Quoter::Summary> participants; // in config order
+    SimStats stats;
+};
+
+// Run the tape through the simulated exchange with the given participants.
+SimResult run_exchange_sim(const std::vector<exchange::Order>& tape,
+                           const std::vector<ParticipantConfig>& participants, const SimConfig& cfg);
+
+} // namespace nanomarket::backtest
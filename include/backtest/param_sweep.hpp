@@ -0,0 +1,54 @@
+// backtest/param_sweep.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+#include "exchange/order_book.hpp"
+#include "risk/risk.hpp"
+#include "strategy/quoter.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace nanomarket::backtest {
+
+// Parameter sweep: one decoded tape, K independent book + Quoter + risk instances.
+//
+// Each instance owns its OrderBook, RiskEngine and Quoter, so configurations never interact and
+// each result equals running that configuration alone (run_single). Tape orders are the rest of
+// the market: they go straight to the book; only the Quoter's orders pass the instance's risk.
+//
+// Instances are split across threads. Within a thread the tape is walked in chunks of
+// `batch_events`, and every instance of the thread consumes the chunk before moving on, so the
+// chunk stays in cache while each instance's book stays hot for a whole chunk.
+
+struct SweepConfig {
+    exchange::OrderBook::Config book{1, 64, 1024, 10000};
+    size_t batch_events = 256;
+    unsigned threads = 0; // 0 = hardware concurrency
+    // Risk limits applied to every instance (RiskEngine defaults unless overridden).
+    int64_t max_position = 100;
+    int64_t max_order_size = 50;
+    int64_t max_notional = 1000000;
+};
+
+struct SweepResult {
+    strategy::Quoter::Settings settings;
+    strategy::Quoter::Summary summary;
+};
+
+// Build the full grid spread x size x max_size, in that nesting order.
+std::vector<strategy::Quoter::Settings> make_grid(const std::vector<int32_t>& spreads,
+                                                  const std::vector<int32_t>& sizes,
+                                                  const std::vector<int32_t>& max_sizes);
+
+// Run one configuration over the tape on the calling thread.
+SweepResult run_single(const std::vector<exchange::Order>& tape, const strategy::Quoter::Settings& s,
+                       const SweepConfig& cfg);
+
+// Run every configuration over the tape. Results are returned in grid order.
+std::vector<SweepResult> run_sweep(const std::vector<exchange::Order>& tape,
+                                   const std::vector<strategy::Quoter::Settings>& grid,
+                                   const SweepConfig& cfg);
+
+} // namespace nanomarket::backtest
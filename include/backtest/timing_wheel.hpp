@@ -0,0 +1,160 @@
+// backtest/timing_wheel.hpp
+#pragma once
+
+#include "core/types.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace nanomarket::backtest {
+
+// Hierarchical timing wheel keyed by logical core::Timestamp (one tick = 1 ns).
+//
+// Eight levels of 256 slots cover the full 64-bit range, so there is no overflow list. An entry
+// sits on the level of the highest 8-bit digit in which its time differs from now(); level 0
+// holds the current 256-tick block. schedule() is O(1). pop() finds the next occupied slot
+// through per-level occupancy bitmaps. When level 0 runs dry it cascades one higher slot down,
+// so each entry moves at most once per level.
+//
+// Events for the same timestamp pop in scheduling order: slot lists are FIFO, and a cascade
+// always runs before anything can be scheduled directly into the block it fills. Entries come
+// from a pool sized at construction; schedule() returns false when the pool is exhausted.
+
+template<typename T>
+class TimingWheel {
+    static_assert(std::is_trivially_copyable_v<T>, "payloads are copied in and out of the pool");
+public:
+    explicit TimingWheel(size_t capacity) : pool_(capacity) {
+        for (size_t i = 0; i < capacity; ++i) pool_[i].next = (i + 1 < capacity) ? static_cast<uint32_t>(i + 1) : kNil;
+        free_ = capacity ? 0 : kNil;
+        for (auto& level : slots_)
+            for (auto& s : level) s = Slot{};
+    }
+
+    // Schedule `v` at `at`. Times before now() are treated as now().
+    bool schedule(core::Timestamp at, const T& v) noexcept {
+        if (free_ == kNil) return false;
+        const uint32_t n = free_;
+        free_ = pool_[n].next;
+        pool_[n].at = at < now_ ? now_ : at;
+        pool_[n].value = v;
+        link(n);
+        ++size_;
+        return true;
+    }
+
+    // Remove the earliest entry (FIFO among equal times) and advance now() to its time.
+    bool pop(core::Timestamp& at, T& out) noexcept {
+        if (size_ == 0) return false;
+        for (;;) {
+            const uint64_t cur = static_cast<uint64_t>(now_);
+            const int s0 = next_occupied(0, static_cast<int>(cur & kMask) - 1);
+            if (s0 >= 0) {
+                now_ = static_cast<core::Timestamp>((cur & ~kMask) | static_cast<uint64_t>(s0));
+                const uint32_t n = unlink_head(0, s0);
+                at = pool_[n].at;
+                out = pool_[n].value;
+                pool_[n].next = free_;
+                free_ = n;
+                --size_;
+                return true;
+            }
+            cascade_next();
+        }
+    }
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return pool_.size(); }
+    core::Timestamp now() const noexcept { return now_; }
+
+private:
+    static constexpr int kLevels = 8;
+    static constexpr int kSlotBits = 8;
+    static constexpr int kSlots = 1 << kSlotBits;
+    static constexpr uint64_t kMask = kSlots - 1;
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+
+    struct Node {
+        core::Timestamp at;
+        uint32_t next;
+        T value;
+    };
+    struct Slot {
+        uint32_t head = kNil;
+        uint32_t tail = kNil;
+    };
+
+    static int digit(uint64_t t, int level) noexcept { return static_cast<int>((t >> (level * kSlotBits)) & kMask); }
+
+    void link(uint32_t n) noexcept {
+        const uint64_t t = static_cast<uint64_t>(pool_[n].at);
+        const uint64_t diff = t ^ static_cast<uint64_t>(now_);
+        const int level = diff ? (63 - std::countl_zero(diff)) / kSlotBits : 0;
+        const int s = digit(t, level);
+        Slot& slot = slots_[level][s];
+        pool_[n].next = kNil;
+        if (slot.tail == kNil) slot.head = n;
+        else pool_[slot.tail].next = n;
+        slot.tail = n;
+        occupied_[level][s >> 6] |= uint64_t{1} << (s & 63);
+    }
+
+    uint32_t unlink_head(int level, int s) noexcept {
+        Slot& slot = slots_[level][s];
+        const uint32_t n = slot.head;
+        slot.head = pool_[n].next;
+        if (slot.head == kNil) {
+            slot.tail = kNil;
+            occupied_[level][s >> 6] &= ~(uint64_t{1} << (s & 63));
+        }
+        return n;
+    }
+
+    // First occupied slot of `level` with index > `after`, or -1.
+    int next_occupied(int level, int after) const noexcept {
+        int from = after + 1;
+        while (from < kSlots) {
+            const int w = from >> 6;
+            const uint64_t bits = occupied_[level][w] & (~uint64_t{0} << (from & 63));
+            if (bits) return (w << 6) + std::countr_zero(bits);
+            from = (w + 1) << 6;
+        }
+        return -1;
+    }
+
+    // Level 0 has nothing at or after now(): jump to the start of the next occupied higher slot
+    // and redistribute its entries onto lower levels.
+    void cascade_next() noexcept {
+        const uint64_t cur = static_cast<uint64_t>(now_);
+        for (int level = 1; level < kLevels; ++level) {
+            const int s = next_occupied(level, digit(cur, level));
+            if (s < 0) continue;
+            const int shift = level * kSlotBits;
+            const uint64_t high = (level + 1 < kLevels) ? (cur >> (shift + kSlotBits)) << (shift + kSlotBits) : 0;
+            now_ = static_cast<core::Timestamp>(high | (static_cast<uint64_t>(s) << shift));
+            Slot& slot = slots_[level][s];
+            uint32_t n = slot.head;
+            slot = Slot{};
+            occupied_[level][s >> 6] &= ~(uint64_t{1} << (s & 63));
+            while (n != kNil) {
+                const uint32_t next = pool_[n].next;
+                link(n);
+                n = next;
+            }
+            return;
+        }
+    }
+
+    std::vector<Node> pool_;
+    uint32_t free_ = kNil;
+    size_t size_ = 0;
+    core::Timestamp now_ = 0;
+    Slot slots_[kLevels][kSlots];
+    uint64_t occupied_[kLevels][kSlots / 64] = {};
+};
+
+} // namespace nanomarket::backtest
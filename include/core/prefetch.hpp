@@ -0,0 +1,13 @@
+// core/prefetch.hpp
+#pragma once
+
+// Software prefetch of a cache line that is about to be read and written. A hint only: it never
+// faults and compiles to nothing where the compiler offers no intrinsic.
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define NANOMARKET_PREFETCH(p) _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define NANOMARKET_PREFETCH(p) __builtin_prefetch((p), 1, 3)
+#else
+#define NANOMARKET_PREFETCH(p) ((void)(p))
+#endif
@@ -3,12 +3,20 @@
 
 #include "core/types.hpp"
 #include "exchange/order.hpp"
+#include "exchange/market_snapshot.hpp"
 #include "exchange/order_book.hpp"
+#include "exchange/replay_decoder.hpp"
+#include "exchange/replay_digest.hpp"
 #include "risk/risk.hpp"
+#include "latency/histogram.hpp"
+#include "latency/pacer.hpp"
 #include "latency/timer.hpp"
 
 #include <string>
 #include <cstdio>
+#include <vector>
+
+namespace nanomarket::feed { class FeedPublisher; }
 
 namespace nanomarket::exchange {
 
@@ -20,7 +28,34 @@ class MarketDataReplayer {
 public:
     struct Config {
         const char* infile = nullptr;
-        const char* outfile = "replay.log";
+        const char* outfile = "replay.log"; // nullptr: no text log (e.g. digest-only runs)
+        // Optional binary feed. Executions, resting adds and top-of-book changes are handed to the
+        // publisher's ring; the publisher thread does the batching and socket I/O.
+        nanomarket::feed::FeedPublisher* feed = nullptr;
+        // Optional streaming digest of the same records the text log contains.
+        ReplayDigest* digest = nullptr;
+        // Optional lock-free snapshot publication for monitoring threads, once per input event.
+        SnapshotPublisher* snapshots = nullptr;
+        // > 0: paced open-loop mode. Each event is released at its ts offset from the first event,
+        // scaled to nanoseconds by `tape_time_scale` and divided by `speed` (2.0 = twice real
+        // time), whether or not earlier events have finished.
+        // 0: replay as fast as possible.
+        double speed = 0.0;
+        // Nanoseconds per unit of the tape's ts column, as backtest::SimConfig::tape_time_scale.
+        int64_t tape_time_scale = 1;
+    };
+
+    // Paced-mode measurements. `latency` runs from an event's scheduled release to the end of
+    // its processing, so time spent queued behind a slow event is counted (coordinated-omission
+    // correction); `service` runs from the actual start and excludes that queueing.
+    struct PacedStats {
+        nanomarket::latency::Histogram latency;
+        nanomarket::latency::Histogram service;
+        // Events completed in each wall-clock second of the run. Sized once to kMaxPacedSeconds
+        // before the first event and trimmed after the last; later completions count in the last entry.
+        std::vector<uint64_t> per_second;
+        int64_t max_lag_ns = 0;           // furthest an event started behind its schedule
+        int64_t wall_ns = 0;
     };
 
     MarketDataReplayer(const Config& cfg, OrderBook& book, nanomarket::risk::RiskEngine& risk) noexcept;
@@ -29,19 +64,30 @@ public:
     // Run replay to completion. Returns 0 on success.
     int run() noexcept;
 
+    const PacedStats& paced_stats() const noexcept { return paced_; }
+
+    static constexpr size_t kMaxPacedSeconds = 86400;
+
 private:
     Config cfg_;
     OrderBook& book_;
     nanomarket::risk::RiskEngine& risk_;
 
-    // deterministic timestamp if not supplied by input
-    core::Timestamp logical_ts_ = 1;
+    // CSV parsing and logical timestamps (shared with the other replay modes)
+    ReplayDecoder decoder_;
 
     // internal FILE* for deterministic logging (avoid iostream overhead ordering differences)
     FILE* logf_ = nullptr;
 
-    // parse a CSV line into an Order. Returns true if parsed.
-    bool parse_line(char* buf, Order& out) noexcept;
+    // last top of book handed to the feed, so only changes are published
+    OrderBook::TopOfBook last_top_{};
+
+    // paced mode
+    nanomarket::latency::Pacer pacer_;
+    PacedStats paced_;
+
+    void process_event(const Order& o, Execution* out_execs) noexcept;
+    void publish_feed(const Order& o, const Execution* execs, size_t n, core::Qty rested) noexcept;
 };
 
 } // namespace nanomarket::exchange
@@ -8,6 +8,7 @@
 #include <vector>
 #include <optional>
 #include <cstdint>
+#include <span>
 
 namespace nanomarket::exchange {
 
@@ -19,16 +20,59 @@ class OrderBook {
 public:
     struct Config { core::Price tick; int32_t levels; int32_t max_orders; core::Price ref_price; };
 
+    // Best price and aggregate quantity resting at that price on each side.
+    // A side with no resting orders reports price 0 and qty 0.
+    struct TopOfBook {
+        core::Price bid_px{0};
+        core::Qty bid_qty{0};
+        core::Price ask_px{0};
+        core::Qty ask_qty{0};
+
+        bool operator==(const TopOfBook&) const noexcept = default;
+    };
+
+    struct DepthLevel {
+        core::Price px{0};
+        core::Qty qty{0};
+        int32_t orders{0};
+    };
+
     explicit OrderBook(const Config& cfg) noexcept;
 
     // Submit order into book; matching occurs immediately (single-threaded).
     // Writes up to `max_out` Execution entries into `out` and returns the number written.
+    // If `rested` is given it receives the quantity left resting on the book: 0 when the order
+    // filled completely, was a market order, or found the order pool full.
     // No heap allocation occurs in the hot path.
-    size_t submit_order(const Order& o, Execution* out, size_t max_out) noexcept;
+    size_t submit_order(const Order& o, Execution* out, size_t max_out, core::Qty* rested = nullptr) noexcept;
+
+    static constexpr size_t kBatchMaxExecs = 128;
+    static constexpr size_t kPrefetchAhead = 4;
+
+    // Submit `orders` in sequence with the same results as calling submit_order on each in turn.
+    // Price levels for the batch are resolved up front in one pass, and while order i matches,
+    // the ladder heads and first resting orders order i + kPrefetchAhead will touch are
+    // prefetched, overlapping their cache misses with useful work.
+    //
+    // For each order, `admit(i, order)` runs first, right before that order would match, so it
+    // sees the effect of every earlier order (e.g. a risk check). Then `sink(i, order, accepted,
+    // execs, n)` receives that order's outcome: up to MaxExecs executions, valid only during the
+    // call. Like `max_out` for submit_order, MaxExecs should match what the sink can keep; further
+    // executions still happen in the book but are not reported. Returns the number of orders admitted.
+    template<size_t MaxExecs = kBatchMaxExecs, typename Admit, typename Sink>
+    size_t submit_batch(std::span<const Order> orders, Admit&& admit, Sink&& sink) noexcept;
 
     // Cancel order by id (best-effort)
     bool cancel(core::OrderId id) noexcept;
 
+    // Scan the ladders for the current best bid/ask. O(L + orders at the best level);
+    // intended for publishing/monitoring, not for use inside matching.
+    TopOfBook top_of_book() const noexcept;
+
+    // Aggregate the best `max_levels` non-empty ladder levels of one side, best first, into `out`.
+    // Returns the number written. Clamped edge levels report their best price and total quantity.
+    size_t depth(core::Side side, DepthLevel* out, size_t max_levels) const noexcept;
+
 private:
     const Config cfg_;
 
@@ -45,6 +89,51 @@ private:
     int32_t alloc_order(const Order& o) noexcept;
     void free_order(int32_t idx) noexcept;
     int32_t price_to_level(core::Price p) const noexcept;
+
+    // submit_order with the resting level already known (-1: compute it from the price)
+    size_t submit_resolved(const Order& o, int32_t level, Execution* out, size_t max_out, core::Qty* rested) noexcept;
+
+    // Batch-only prefetch state: the first non-empty level of each ladder, or -1 when unknown.
+    // Found by one scan per chunk and kept roughly current by submit_batch, so submit_order
+    // pays nothing for it. Only aims prefetches; matching never relies on it.
+    struct FirstLevels {
+        int32_t bid;
+        int32_t ask;
+    };
+    static constexpr int32_t kHintProbe = 4; // empty levels skipped before a stale hint gives up
+    FirstLevels first_levels() const noexcept;
+    void resolve_levels(const Order* orders, size_t n, int32_t* levels) const noexcept;
+    void prefetch_for(const Order& o, int32_t level, FirstLevels& first) const noexcept;
+    void note_rested(const Order& o, int32_t level, FirstLevels& first) const noexcept;
 };
 
+template<size_t MaxExecs, typename Admit, typename Sink>
+size_t OrderBook::submit_batch(std::span<const Order> orders, Admit&& admit, Sink&& sink) noexcept {
+    constexpr size_t kChunk = 256;
+    static_assert(MaxExecs > 0, "the sink needs room for at least one execution");
+    Execution execs[MaxExecs];
+    int32_t levels[kChunk];
+    size_t admitted = 0;
+    for (size_t base = 0; base < orders.size(); base += kChunk) {
+        const size_t n = (orders.size() - base < kChunk) ? orders.size() - base : kChunk;
+        const Order* chunk = orders.data() + base;
+        resolve_levels(chunk, n, levels);
+        FirstLevels first = first_levels();
+        for (size_t k = 0; k < n && k < kPrefetchAhead; ++k) prefetch_for(chunk[k], levels[k], first);
+        for (size_t k = 0; k < n; ++k) {
+            if (k + kPrefetchAhead < n) prefetch_for(chunk[k + kPrefetchAhead], levels[k + kPrefetchAhead], first);
+            const Order& o = chunk[k];
+            if (!admit(base + k, o)) {
+                sink(base + k, o, false, execs, size_t{0});
+                continue;
+            }
+            ++admitted;
+            const size_t m = submit_resolved(o, levels[k], execs, MaxExecs, nullptr);
+            note_rested(o, levels[k], first);
+            sink(base + k, o, true, execs, m < MaxExecs ? m : MaxExecs);
+        }
+    }
+    return admitted;
+}
+
 } // namespace nanomarket::exchange
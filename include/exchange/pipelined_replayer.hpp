@@ -0,0 +1,114 @@
+// exchange/pipelined_replayer.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+#include "exchange/order_book.hpp"
+#include "exchange/replay_decoder.hpp"
+#include "exchange/replay_digest.hpp"
+#include "risk/risk.hpp"
+#include "utils/ring_buffer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace nanomarket::exchange {
+
+// PipelinedReplayer produces the same log as MarketDataReplayer, split over three threads:
+//
+//   decode (fgets + ReplayDecoder) -> match (risk + OrderBook, single thread, deterministic)
+//                                  -> output (formatting, fwrite, optional digest)
+//
+// Stages exchange fixed-size batches allocated once before the run. SPSC rings of slot indices
+// carry full batches forward and hand emptied batches back, so nothing is allocated or copied
+// per event beyond the records themselves. Matching order is exactly the serial order, so the
+// output is byte-identical to the serial mode.
+//
+// Per-stage counters show which stage limits throughput: busy time (occupancy = busy / wall),
+// input stalls (waiting for the upstream stage) and output stalls (waiting for a free batch,
+// i.e. back-pressure from downstream).
+
+class PipelinedReplayer {
+public:
+    struct Config {
+        const char* infile = nullptr;
+        const char* outfile = "replay.log"; // nullptr: no text log
+        ReplayDigest* digest = nullptr;     // fed by the output stage
+    };
+
+    struct StageStats {
+        uint64_t events = 0;
+        uint64_t batches = 0;
+        int64_t busy_ns = 0;
+        uint64_t input_stalls = 0;   // waits for upstream data
+        int64_t input_stall_ns = 0;
+        uint64_t output_stalls = 0;  // waits for a free batch (downstream back-pressure)
+        int64_t output_stall_ns = 0;
+    };
+
+    struct Stats {
+        StageStats decode, match, output;
+        int64_t wall_ns = 0;
+    };
+
+    PipelinedReplayer(const Config& cfg, OrderBook& book, nanomarket::risk::RiskEngine& risk) noexcept;
+
+    // Run replay to completion. Returns 0 on success.
+    int run() noexcept;
+
+    const Stats& stats() const noexcept { return stats_; }
+
+    static constexpr size_t kBatchEvents = 256;
+    static constexpr size_t kBatchExecs = 4096;
+    static constexpr size_t kMaxExecsPerEvent = 64; // same cap as the serial replayer's buffer
+    static constexpr size_t kSlots = 8;
+    static_assert(kBatchEvents <= nanomarket::risk::BatchTerms::kMax, "one risk precheck per decoded batch");
+
+private:
+    struct DecodedBatch {
+        uint32_t count = 0;
+        bool last = false;
+        Order orders[kBatchEvents];
+    };
+
+    struct EventRecord {
+        Order order;
+        bool rejected;
+        uint32_t exec_begin;
+        uint32_t exec_count;
+        int64_t position;
+        int64_t notional;
+    };
+
+    struct ResultBatch {
+        uint32_t count = 0;
+        uint32_t exec_count = 0;
+        bool last = false;
+        EventRecord events[kBatchEvents];
+        Execution execs[kBatchExecs];
+    };
+
+    using IndexRing = nanomarket::utils::SpscRing<uint32_t, 16>;
+
+    void decode_stage(FILE* in) noexcept;
+    void match_stage() noexcept;
+    void output_stage(FILE* out) noexcept;
+
+    // Pop from `ring`, spinning (and accounting the stall) while it is empty.
+    static uint32_t take(IndexRing& ring, uint64_t& stalls, int64_t& stall_ns) noexcept;
+
+    Config cfg_;
+    OrderBook& book_;
+    nanomarket::risk::RiskEngine& risk_;
+
+    std::vector<DecodedBatch> decoded_;
+    std::vector<ResultBatch> results_;
+    IndexRing decoded_full_, decoded_free_;
+    IndexRing results_full_, results_free_;
+
+    nanomarket::risk::BatchTerms terms_;
+    Stats stats_;
+};
+
+} // namespace nanomarket::exchange
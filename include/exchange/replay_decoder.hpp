@@ -0,0 +1,29 @@
+// exchange/replay_decoder.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+
+#include <vector>
+
+namespace nanomarket::exchange {
+
+// ReplayDecoder turns lines of the replay CSV into Orders. It is shared by every replay mode so
+// they all see identical orders and logical timestamps. The only state is the logical timestamp
+// counter used when a line carries no ts column.
+
+class ReplayDecoder {
+public:
+    // parse a CSV line into an Order. Returns true if parsed.
+    bool parse_line(char* buf, Order& out) noexcept;
+
+    // Decode a whole file up front (for modes that replay the same tape several times).
+    // Returns false if the file cannot be opened.
+    static bool decode_file(const char* path, std::vector<Order>& out);
+
+private:
+    // deterministic timestamp if not supplied by input
+    core::Timestamp logical_ts_ = 1;
+};
+
+} // namespace nanomarket::exchange
@@ -0,0 +1,69 @@
+// exchange/replay_digest.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace nanomarket::exchange {
+
+// ReplayDigest folds replay output into a compact chain of checkpoints so two runs can be
+// compared without keeping or diffing their text logs.
+//
+// Every reject, execution and risk snapshot is hashed from its binary fields (no formatting) with
+// a fast non-cryptographic 64-bit mixer. Every `interval` input events the segment hash is folded
+// into a running chain and recorded as a checkpoint. Once two runs diverge their chains differ
+// at every later checkpoint, so the first divergent segment can be found by binary search.
+
+class ReplayDigest {
+public:
+    struct Checkpoint {
+        uint64_t events;  // input events covered so far (end of segment, exclusive)
+        uint64_t segment; // hash of this segment only
+        uint64_t chain;   // hash of all segments up to and including this one
+
+        bool operator==(const Checkpoint&) const noexcept = default;
+    };
+
+    struct Divergence {
+        bool diverged = false;
+        size_t checkpoint = 0;   // index of the first differing checkpoint
+        uint64_t first_event = 0; // divergent range [first_event, end_event)
+        uint64_t end_event = 0;
+    };
+
+    explicit ReplayDigest(uint64_t interval = 1u << 20) noexcept;
+
+    // Per-event records, in output order.
+    void on_reject(const Order& o) noexcept;
+    void on_execution(const Execution& e) noexcept;
+    void on_risk(core::Timestamp ts, int64_t position, int64_t notional) noexcept;
+    // Close the current input event; records a checkpoint every `interval` events.
+    void end_event() noexcept;
+    // Record the trailing partial segment, if any. Call once after the run.
+    void finish() noexcept;
+
+    uint64_t interval() const noexcept { return interval_; }
+    uint64_t events() const noexcept { return events_; }
+    const std::vector<Checkpoint>& checkpoints() const noexcept { return checkpoints_; }
+
+    // Compact binary golden file: header + one 24-byte record per checkpoint.
+    bool save(const char* path) const noexcept;
+    static bool load(const char* path, uint64_t& interval, std::vector<Checkpoint>& out);
+
+    // Locate the first divergent event range between two checkpoint chains.
+    static Divergence compare(const std::vector<Checkpoint>& a, const std::vector<Checkpoint>& b) noexcept;
+
+private:
+    void mix(uint64_t v) noexcept;
+
+    uint64_t interval_;
+    uint64_t events_{0};
+    uint64_t segment_;
+    uint64_t chain_{0};
+    std::vector<Checkpoint> checkpoints_;
+};
+
+} // namespace nanomarket::exchange
@@ -0,0 +1,26 @@
+// exchange/replay_format.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+
+#include <cstdio>
+
+namespace nanomarket::exchange {
+
+// Text record formats of the replay log. Every replay mode writes through these so their output
+// stays byte-identical (tests/golden_replay.log depends on it).
+
+inline void write_reject(FILE* f, const Order& o) noexcept {
+    std::fprintf(f, "TS=%lld,ORDER=%llu,%c,REJECTED\n", (long long)o.ts, (unsigned long long)o.id, (o.side==core::Side::Buy)?'B':'S');
+}
+
+inline void write_execution(FILE* f, const Execution& e) noexcept {
+    std::fprintf(f, "TS=%lld,EXEC,rest=%llu,in=%llu,qty=%d,px=%lld\n", (long long)e.ts, (unsigned long long)e.resting_id, (unsigned long long)e.incoming_id, (int)e.filled_qty, (long long)e.price);
+}
+
+inline void write_risk(FILE* f, core::Timestamp ts, int64_t pos, int64_t notl) noexcept {
+    std::fprintf(f, "TS=%lld,RISK,position=%lld,notional=%lld\n", (long long)ts, (long long)pos, (long long)notl);
+}
+
+} // namespace nanomarket::exchange
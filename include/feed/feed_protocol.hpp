@@ -0,0 +1,75 @@
+// feed/feed_protocol.hpp
+#pragma once
+
+#include "core/types.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace nanomarket::feed {
+
+// Binary wire format for the market-data feed. Host byte order (publisher and subscribers
+// share a host or an architecture). Every datagram is a PacketHeader followed by `count`
+// fixed-size Messages carrying consecutive sequence numbers starting at `seq`, except an
+// unavailable reply (kFlagUnavailable), which is a bare header naming a lost range.
+
+inline constexpr uint32_t kPacketMagic = 0x464D4E31;   // "1NMF"
+inline constexpr uint32_t kRequestMagic = 0x524D4E31;  // "1NMR"
+inline constexpr uint16_t kProtocolVersion = 1;
+
+// Keep datagrams below a typical Ethernet MTU so they are never fragmented.
+inline constexpr size_t kMaxDatagram = 1400;
+
+enum class MsgType : uint8_t {
+    Add = 1,          // limit order residual rested on the book
+    Cancel = 2,       // resting order removed (not published yet: replay input has no cancels)
+    Execution = 3,    // resting order (id) filled against incoming order (id2)
+    TopOfBook = 4,    // best bid (price, qty) / best ask (price2, qty2) changed
+    EndOfSession = 5, // last message of the session; id = last sequence number before it
+};
+
+enum PacketFlags : uint16_t {
+    kFlagRetransmit = 1,  // packet answers a retransmit request (not live data)
+    kFlagUnavailable = 2, // with kFlagRetransmit: [seq, seq + count) can no longer be supplied
+                          // and is lost for good; no messages follow the header
+};
+
+struct PacketHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint64_t seq;            // sequence number of the first message in the packet
+    core::Timestamp send_ns; // publisher wall clock at send, for latency measurement
+    uint16_t count;
+    uint16_t reserved[3];
+};
+
+struct Message {
+    MsgType type;
+    int8_t side;          // core::Side of the order (aggressor side for executions)
+    uint16_t reserved;
+    core::Qty qty;
+    core::Qty qty2;
+    uint32_t reserved2;
+    core::OrderId id;
+    core::OrderId id2;
+    core::Price price;
+    core::Price price2;
+    core::Timestamp ts;   // logical (deterministic) timestamp of the event
+};
+
+// Sent by a subscriber to the publisher's retransmit port to recover [seq, seq + count).
+struct RetransmitRequest {
+    uint32_t magic;
+    uint32_t count;
+    uint64_t seq;
+};
+
+static_assert(sizeof(PacketHeader) == 32, "wire layout changed");
+static_assert(sizeof(Message) == 56, "wire layout changed");
+static_assert(sizeof(RetransmitRequest) == 16, "wire layout changed");
+static_assert(std::is_trivially_copyable_v<Message>);
+
+inline constexpr size_t kMaxMsgsPerPacket = (kMaxDatagram - sizeof(PacketHeader)) / sizeof(Message);
+
+} // namespace nanomarket::feed
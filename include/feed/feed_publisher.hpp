@@ -0,0 +1,105 @@
+// feed/feed_publisher.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+#include "exchange/order_book.hpp"
+#include "feed/feed_protocol.hpp"
+#include "feed/udp_socket.hpp"
+#include "utils/ring_buffer.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace nanomarket::feed {
+
+// FeedPublisher packs book events into sequence-numbered binary datagrams (see feed_protocol.hpp).
+//
+// The matching thread only calls the on_* methods, which copy a 56-byte message into an SPSC ring
+// and return; they never block or touch a socket. If the ring is full the message is dropped and
+// counted in Stats::dropped (size the ring for the burst rate with Config::ring_capacity). A drop
+// still consumes its sequence number, so subscribers see a gap, and retransmit requests for it are
+// answered unavailable.
+//
+// A background thread drains the ring, assigns sequence numbers, batches up to kMaxMsgsPerPacket
+// messages per datagram and sends them to the live endpoint (unicast or multicast). The last
+// `retransmit_window` messages are kept so subscribers can recover gaps by sending a
+// RetransmitRequest to the retransmit port.
+
+class FeedPublisher {
+public:
+    struct Config {
+        const char* feed_ip = "127.0.0.1";   // unicast or multicast (224.0.0.0/4) destination
+        uint16_t feed_port = 30001;
+        uint16_t retransmit_port = 30002;    // bound on INADDR_ANY
+        uint32_t retransmit_window = 65536;  // messages kept for gap recovery, power of two
+        int multicast_ttl = 1;
+        int linger_ms = 200;                 // keep serving retransmits this long after stop()
+        uint32_t drop_every = 0;             // fault injection: skip every Nth live packet (0 = off)
+        size_t ring_capacity = 4096;         // matching-to-sender ring, rounded up to a power of two
+    };
+
+    struct Stats {
+        uint64_t messages;            // messages sequenced and sent
+        uint64_t packets;             // live datagrams sent
+        uint64_t dropped;             // messages lost because the matching-side ring was full (sequence skipped)
+        uint64_t retransmit_requests;
+        uint64_t retransmitted;       // messages re-sent on request
+    };
+
+    explicit FeedPublisher(const Config& cfg) noexcept;
+    ~FeedPublisher();
+
+    FeedPublisher(const FeedPublisher&) = delete;
+    FeedPublisher& operator=(const FeedPublisher&) = delete;
+
+    // Open sockets and start the sender thread. Returns false if sockets cannot be set up.
+    bool start() noexcept;
+    // Flush pending messages, publish EndOfSession, serve retransmits for `linger_ms`, then join.
+    void stop() noexcept;
+
+    // Matching-thread API (non-blocking).
+    void on_add(const exchange::Order& o, core::Qty resting_qty) noexcept;
+    void on_execution(const exchange::Execution& e, core::Side aggressor) noexcept;
+    void on_top_of_book(const exchange::OrderBook::TopOfBook& top, core::Timestamp ts) noexcept;
+
+    Stats stats() const noexcept;
+
+private:
+    using Ring = utils::DynamicSpscRing<Message>;
+
+    // Ring entry standing for `id` messages the matching thread had to drop, and store_ entry for a
+    // sequence number that carries no message. Never sent: the zero type is not valid on the wire.
+    static constexpr MsgType kSkipped = MsgType{};
+
+    void push(const Message& m) noexcept;
+    void run() noexcept;
+    void send_live(const Message* msgs, uint16_t count) noexcept;
+    void skip_seqs(uint64_t count) noexcept;
+    void serve_retransmits() noexcept;
+    void send_packet(UdpSocket& sock, const Message* msgs, uint16_t count, uint64_t seq, uint16_t flags, const Endpoint& to) noexcept;
+
+    Config cfg_;
+    std::unique_ptr<Ring> ring_;
+    uint64_t unreported_drops_{0}; // matching thread: drops not yet announced through the ring
+    std::thread thr_;
+    std::atomic<bool> running_{false};
+
+    // sender-thread state
+    UdpSocket live_sock_;
+    UdpSocket rtx_sock_;
+    Endpoint feed_ep_{};
+    std::vector<Message> store_; // retransmit window indexed by seq & mask
+    uint64_t next_seq_{1};
+    uint64_t live_packets_{0};
+
+    std::atomic<uint64_t> messages_{0};
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> rtx_requests_{0};
+    std::atomic<uint64_t> rtx_messages_{0};
+};
+
+} // namespace nanomarket::feed
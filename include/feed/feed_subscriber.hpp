@@ -0,0 +1,93 @@
+// feed/feed_subscriber.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order_book.hpp"
+#include "feed/feed_protocol.hpp"
+#include "feed/udp_socket.hpp"
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace nanomarket::feed {
+
+// Reference subscriber for FeedPublisher. Applies messages strictly in sequence order to a shadow
+// book, buffers out-of-order messages, and asks the publisher's retransmit port for missing ranges.
+// Only when the publisher answers that a range is unavailable (kFlagUnavailable) does the
+// subscriber skip it and count it as lost.
+// This is a consumer-side tool, so it uses ordinary containers rather than fixed pools.
+
+class FeedSubscriber {
+public:
+    struct Config {
+        const char* feed_ip = "127.0.0.1";      // unicast address to bind, or multicast group to join
+        uint16_t feed_port = 30001;
+        const char* publisher_ip = "127.0.0.1"; // where retransmit requests are sent
+        uint16_t retransmit_port = 30002;
+        int64_t retransmit_timeout_ns = 2'000'000; // re-request an unfilled gap after this long
+    };
+
+    struct Stats {
+        uint64_t packets;       // datagrams received (live + retransmit)
+        uint64_t applied;       // messages applied in order
+        uint64_t duplicates;    // messages already applied
+        uint64_t gaps;          // gaps detected on the live channel
+        uint64_t requests;      // retransmit requests sent
+        uint64_t lost;          // messages the publisher reported unavailable
+        uint64_t top_mismatches; // TopOfBook messages disagreeing with the shadow book
+    };
+
+    explicit FeedSubscriber(const Config& cfg) noexcept;
+
+    bool open() noexcept;
+
+    // Receive and apply datagrams for up to `timeout_us`. Returns true while the session is live.
+    bool poll(int64_t timeout_us) noexcept;
+    // True once EndOfSession has been applied in sequence (i.e. every gap before it was closed).
+    bool finished() const noexcept { return finished_; }
+
+    // Shadow book rebuilt from Add/Execution/Cancel messages.
+    exchange::OrderBook::TopOfBook top_of_book() const noexcept;
+    size_t resting_orders() const noexcept { return orders_.size(); }
+    // Last TopOfBook message received from the publisher.
+    const exchange::OrderBook::TopOfBook& published_top() const noexcept { return published_top_; }
+
+    const Stats& stats() const noexcept { return stats_; }
+    // Publisher send to subscriber receive, one sample per live packet, in nanoseconds.
+    const std::vector<int64_t>& latencies_ns() const noexcept { return latencies_; }
+
+    // Optional per-message callback, invoked in sequence order after the shadow book is updated.
+    std::function<void(uint64_t seq, const Message&)> on_message;
+
+private:
+    struct Resting { core::Side side; core::Price price; core::Qty qty; };
+
+    void handle_packet(const unsigned char* buf, int len) noexcept;
+    void accept(uint64_t seq, const Message& m) noexcept;
+    void apply(const Message& m) noexcept;
+    void drain_pending() noexcept;
+    void skip_lost(uint64_t from, uint64_t end) noexcept;
+    void request(uint64_t seq, uint64_t count) noexcept;
+
+    Config cfg_;
+    UdpSocket sock_;
+    Endpoint rtx_ep_{};
+
+    uint64_t expected_{1};
+    uint64_t highest_seen_{0};
+    std::map<uint64_t, Message> pending_; // out-of-order messages awaiting the gap fill
+    core::Timestamp last_request_ns_{0};
+    bool finished_{false};
+
+    std::unordered_map<core::OrderId, Resting> orders_;
+    std::map<core::Price, core::Qty> bids_;
+    std::map<core::Price, core::Qty> asks_;
+    exchange::OrderBook::TopOfBook published_top_{};
+
+    Stats stats_{};
+    std::vector<int64_t> latencies_;
+};
+
+} // namespace nanomarket::feed
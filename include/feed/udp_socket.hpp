@@ -0,0 +1,53 @@
+// feed/udp_socket.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nanomarket::feed {
+
+// IPv4 address + port in network byte order.
+struct Endpoint {
+    uint32_t addr{0};
+    uint16_t port{0};
+};
+
+// Parse a dotted-quad IPv4 address. Returns false on malformed input.
+bool make_endpoint(const char* ip, uint16_t port, Endpoint& out) noexcept;
+bool is_multicast(const Endpoint& ep) noexcept;
+
+// Minimal non-blocking UDP socket over BSD sockets / Winsock. Setup calls return false on
+// failure; send/recv never block. Not used on the matching thread.
+class UdpSocket {
+public:
+    UdpSocket() noexcept = default;
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    bool open() noexcept;
+    void close() noexcept;
+    bool is_open() const noexcept;
+
+    // Bind to `ep`. Address reuse is enabled so several subscribers can share a multicast port.
+    bool bind(const Endpoint& ep) noexcept;
+    bool join_group(const Endpoint& group) noexcept;
+    bool set_multicast_options(int ttl, bool loopback) noexcept;
+
+    // Returns bytes sent, or -1 on failure.
+    int send_to(const void* data, size_t len, const Endpoint& to) noexcept;
+    // Returns bytes received, or -1 if nothing is pending.
+    int recv_from(void* data, size_t len, Endpoint* from) noexcept;
+    // Wait up to `timeout_us` for a datagram. Returns true if one is pending.
+    bool wait_readable(int64_t timeout_us) noexcept;
+
+private:
+#if defined(_WIN32)
+    uintptr_t fd_ = ~uintptr_t(0);
+#else
+    int fd_ = -1;
+#endif
+};
+
+} // namespace nanomarket::feed
@@ -0,0 +1,42 @@
+// latency/histogram.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nanomarket::latency {
+
+// Fixed-size log-linear latency histogram (no heap, O(1) record). Values below 16 ns are exact;
+// above that each power of two is split into 16 sub-buckets, so a reported percentile is within
+// 1/16 (6.25%) above the true value. Covers the full non-negative int64 range.
+
+class Histogram {
+public:
+    void record(int64_t ns) noexcept;
+    void merge(const Histogram& other) noexcept;
+    void reset() noexcept;
+
+    uint64_t count() const noexcept { return count_; }
+    int64_t min() const noexcept { return count_ ? min_ : 0; }
+    int64_t max() const noexcept { return max_; }
+    double mean() const noexcept { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    // Upper bound of the bucket holding the `p`-th percentile (0 < p <= 100), clamped to max().
+    int64_t percentile(double p) const noexcept;
+
+private:
+    static constexpr int kSubBits = 4;
+    static constexpr int kSub = 1 << kSubBits;
+    static constexpr size_t kBuckets = (63 - kSubBits + 1) * kSub;
+
+    static size_t bucket_of(uint64_t v) noexcept;
+    static int64_t bucket_upper(size_t idx) noexcept;
+
+    uint64_t buckets_[kBuckets] = {};
+    uint64_t count_ = 0;
+    int64_t sum_ = 0;
+    int64_t min_ = INT64_MAX;
+    int64_t max_ = 0;
+};
+
+} // namespace nanomarket::latency
@@ -0,0 +1,40 @@
+// latency/pacer.hpp
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define NANOMARKET_CPU_RELAX() _mm_pause()
+#elif defined(__x86_64__) || defined(__i386__)
+#define NANOMARKET_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define NANOMARKET_CPU_RELAX() asm volatile("yield")
+#else
+#define NANOMARKET_CPU_RELAX() ((void)0)
+#endif
+
+namespace nanomarket::latency {
+
+// Releases work at absolute core::now_ns() deadlines. Long waits sleep until a calibrated slack
+// before the deadline, then spin with a pause hint; short waits only spin. calibrate() measures
+// the clock read cost and the scheduler's sleep overshoot on this machine so the sleep phase
+// never overshoots a deadline by more than the spin phase can absorb.
+
+class Pacer {
+public:
+    // Measure clock cost and sleep overshoot. Takes a few milliseconds; call before timing.
+    void calibrate() noexcept;
+
+    // Block until now_ns() >= deadline_ns. Returns the time at which the wait ended.
+    int64_t wait_until(int64_t deadline_ns) const noexcept;
+
+    int64_t clock_cost_ns() const noexcept { return clock_cost_ns_; }
+    int64_t sleep_slack_ns() const noexcept { return sleep_slack_ns_; }
+
+private:
+    int64_t clock_cost_ns_ = 0;
+    int64_t sleep_slack_ns_ = 2'000'000; // conservative until calibrated
+};
+
+} // namespace nanomarket::latency
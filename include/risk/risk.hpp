@@ -2,8 +2,11 @@
 #pragma once
 
 #include "core/types.hpp"
+#include "exchange/order.hpp"
 
 #include <atomic>
+#include <cstddef>
+#include <span>
 
 namespace nanomarket::risk {
 
@@ -13,11 +16,29 @@ struct Limits {
     std::atomic<int64_t> max_notional{1000000};
 };
 
+// Per-order terms of check_new_order that do not depend on engine state, for a whole batch.
+// Kept as separate arrays so prepare_batch is a straight-line loop the compiler can vectorize.
+struct BatchTerms {
+    static constexpr size_t kMax = 256;
+    size_t count = 0;
+    int64_t delta[kMax];    // signed position change: side * qty
+    int64_t notional[kMax]; // price * qty
+    uint8_t size_ok[kMax];  // |qty| within max_order_size
+};
+
 class RiskEngine {
 public:
     RiskEngine() noexcept;
 
     bool check_new_order(core::Price price, core::Qty qty, core::Side side) noexcept;
+
+    // Batch form of check_new_order. prepare_batch computes the stateless terms for the first
+    // min(orders.size(), BatchTerms::kMax) orders and returns that count. check_prepared(t, i)
+    // then applies the position and notional limits against the current state. Call it for
+    // each order right before that order is submitted, after the fills of earlier orders, and
+    // it gives the same answer check_new_order would.
+    size_t prepare_batch(std::span<const nanomarket::exchange::Order> orders, BatchTerms& t) const noexcept;
+    bool check_prepared(const BatchTerms& t, size_t i) const noexcept;
     void on_fill(core::Price price, core::Qty qty, core::Side side) noexcept;
 
     Limits& limits() noexcept { return limits_; }
@@ -25,6 +46,8 @@ public:
     // Non-blocking atomic readers for deterministic snapshots.
     // These return the current single-instrument position and notional exposure.
     // Use acquire ordering to ensure a consistent view when used from other threads.
+    // Each reader is individually atomic; a monitor needing position and notional from the same
+    // moment should read an exchange::SnapshotPublisher snapshot instead.
     int64_t position() const noexcept { return position_.load(std::memory_order_acquire); }
     int64_t notional() const noexcept { return notional_.load(std::memory_order_acquire); }
 
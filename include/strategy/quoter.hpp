@@ -0,0 +1,77 @@
+// strategy/quoter.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+#include "exchange/order_book.hpp"
+#include "strategy/strategy.hpp"
+
+#include <cstdint>
+
+namespace nanomarket::strategy {
+
+// Quoter is the event-driven, deterministic counterpart of MarketMaker for replays and backtests.
+// It keeps at most one bid and one ask resting `spread_ticks` around a reference price (book mid,
+// else last trade, else the configured reference), stops quoting a side once another fill of
+// `size` could take |position| past `max_size`, and accounts for its own fills.
+// No threads, clocks or heap: the caller drives it from the matching loop.
+
+class Quoter {
+public:
+    // Plain copy of Params for code that stores many configurations.
+    struct Settings {
+        int32_t spread_ticks = 2;
+        int32_t size = 1;
+        int32_t max_size = 10;
+    };
+
+    struct Summary {
+        int64_t fills = 0;            // executions involving one of our orders
+        int64_t volume = 0;           // total filled quantity
+        int64_t position = 0;         // signed inventory
+        int64_t max_abs_position = 0;
+        int64_t cash = 0;             // sum of sell proceeds minus buy cost, in price ticks
+        int64_t pnl = 0;              // cash + position marked at the last trade price
+        int64_t quotes = 0;           // quotes sent to the book
+        int64_t rejected = 0;         // quotes refused by risk
+
+        bool operator==(const Summary&) const noexcept = default;
+    };
+
+    static Settings settings_from(const Params& p) noexcept;
+
+    // `id_base` must keep our order ids disjoint from every other participant's.
+    Quoter(const Settings& s, core::Price ref_price, core::OrderId id_base) noexcept;
+
+    bool owns(core::OrderId id) const noexcept { return id >= id_base_ && id < next_id_; }
+
+    // Account for an execution. `incoming_side` is the side of the aggressing order.
+    // Returns the side we traded on (or 0 if neither order is ours).
+    int on_execution(const exchange::Execution& e, core::Side incoming_side) noexcept;
+
+    // Called after one of our quotes was submitted: `filled` is what executed immediately.
+    void on_submitted(const exchange::Order& q, core::Qty filled) noexcept;
+    void on_rejected(const exchange::Order& q) noexcept;
+
+    // Emit up to two quotes for the sides that have nothing resting. Returns the count written.
+    size_t requote(const exchange::OrderBook::TopOfBook& top, core::Timestamp ts, exchange::Order* out) noexcept;
+
+    const Settings& settings() const noexcept { return settings_; }
+    Summary summary() const noexcept;
+
+private:
+    Settings settings_;
+    core::OrderId id_base_;
+    core::OrderId next_id_;
+    core::Price ref_price_;
+    core::Price last_trade_px_;
+
+    core::OrderId bid_id_{0};
+    core::Qty bid_open_{0};
+    core::OrderId ask_id_{0};
+    core::Qty ask_open_{0};
+
+    Summary sum_{};
+};
+
+} // namespace nanomarket::strategy
@@ -4,6 +4,7 @@
 #include "core/types.hpp"
 #include "exchange/order.hpp"
 #include "utils/ring_buffer.hpp"
+#include "utils/shm_ring.hpp"
 
 #include <atomic>
 #include <thread>
@@ -19,6 +20,9 @@ struct Params {
 class MarketMaker {
 public:
     MarketMaker(nanomarket::utils::SpscRing<nanomarket::exchange::Order, 1024>* out_ring);
+    // Out-of-process variant: quotes are pushed into a shared-memory ring attached as producer.
+    // The strategy thread also refreshes the ring heartbeat so the matcher can detect a dead peer.
+    MarketMaker(nanomarket::utils::ShmSpscRing<nanomarket::exchange::Order, 1024>* out_ring);
     ~MarketMaker();
 
     void start();
@@ -27,10 +31,12 @@ public:
 
 private:
     void run();
+    void push(const nanomarket::exchange::Order& o);
     std::thread thr_;
     std::atomic<bool> running_{false};
     Params params_;
-    nanomarket::utils::SpscRing<nanomarket::exchange::Order, 1024>* out_ring_;
+    nanomarket::utils::SpscRing<nanomarket::exchange::Order, 1024>* out_ring_ = nullptr;
+    nanomarket::utils::ShmSpscRing<nanomarket::exchange::Order, 1024>* shm_ring_ = nullptr;
 };
 
 } // namespace nanomarket::strategy
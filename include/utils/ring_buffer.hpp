@@ -2,8 +2,10 @@
 #pragma once
 
 #include <atomic>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <memory>
 
 namespace nanomarket::utils {
 
@@ -39,4 +41,39 @@ private:
     std::atomic<size_t> tail_;
 };
 
+// Same ring with the capacity chosen at run time: rounded up to a power of two and allocated
+// once at construction, never in push/pop.
+template<typename T>
+class DynamicSpscRing {
+public:
+    explicit DynamicSpscRing(size_t capacity)
+        : mask_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1), buffer_(new T[mask_ + 1]), head_(0), tail_(0) {}
+
+    bool push(const T& item) noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        const auto next = (head + 1) & mask_;
+        if (next == tail_.load(std::memory_order_acquire)) return false; // full
+        buffer_[head] = item;
+        head_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) noexcept {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false; // empty
+        out = buffer_[tail];
+        tail_.store((tail + 1) & mask_, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const noexcept { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+    const size_t mask_;
+    std::unique_ptr<T[]> buffer_;
+    std::atomic<size_t> head_;
+    std::atomic<size_t> tail_;
+};
+
 } // namespace nanomarket::utils
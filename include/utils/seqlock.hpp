@@ -0,0 +1,64 @@
+// Sequence-lock publication of a trivially copyable value: one writer, any number of readers
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace nanomarket::utils {
+
+// The writer never waits: it bumps the sequence to odd, stores the value, and bumps it to even.
+// Readers copy the value and retry if the sequence was odd or changed meanwhile, so a successful
+// read is never torn. The payload is held in relaxed atomic words, which keeps concurrent
+// access race-free without locks.
+
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload must be trivially copyable");
+public:
+    SeqLock() noexcept : seq_(0) {
+        for (auto& w : words_) w.store(0, std::memory_order_relaxed);
+    }
+
+    // Single writer only.
+    void store(const T& v) noexcept {
+        uint64_t buf[kWords] = {};
+        std::memcpy(buf, &v, sizeof(T));
+        const uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // One attempt. Returns false if a write was in progress or raced with the copy.
+    bool try_load(T& out) const noexcept {
+        const uint64_t s1 = seq_.load(std::memory_order_acquire);
+        if (s1 & 1) return false;
+        uint64_t buf[kWords];
+        for (size_t i = 0; i < kWords; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != s1) return false;
+        std::memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    // Retry until a consistent copy is obtained.
+    T load() const noexcept {
+        T out;
+        while (!try_load(out)) {}
+        return out;
+    }
+
+    // Number of completed stores.
+    uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + 7) / 8;
+    alignas(64) std::atomic<uint64_t> seq_;
+    std::atomic<uint64_t> words_[kWords];
+};
+
+} // namespace nanomarket::utils
@@ -0,0 +1,49 @@
+// utils/shared_segment.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nanomarket::utils {
+
+// Named shared-memory mapping (POSIX shm_open / Win32 file mapping). Setup happens outside hot
+// paths; failures are reported through bool returns. The creator owns the name and removes it
+// on close (POSIX); on Windows the mapping disappears with its last handle.
+
+class SharedSegment {
+public:
+    SharedSegment() noexcept = default;
+    ~SharedSegment();
+
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+
+    // Create a zero-filled segment of `size` bytes. Fails if `name` already exists: only the
+    // caller can tell whether an existing segment is stale (see remove()).
+    bool create(const char* name, size_t size) noexcept;
+    // Map an existing segment. Fails if it is smaller than `min_size`.
+    bool attach(const char* name, size_t min_size) noexcept;
+    void close() noexcept;
+    // Remove `name` so it can be created again; mappings that are still open stay valid. True if
+    // the name no longer exists. On Windows a mapping lives until its last handle closes, so this
+    // only reports whether one is still open.
+    static bool remove(const char* name) noexcept;
+
+    void* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    bool owner_ = false;
+    char name_[128] = {};
+#if defined(_WIN32)
+    void* handle_ = nullptr;
+#endif
+};
+
+// Process identity helpers used for peer liveness checks across processes.
+uint64_t current_pid() noexcept;
+bool process_alive(uint64_t pid) noexcept;
+
+} // namespace nanomarket::utils
@@ -0,0 +1,202 @@
+// Single-producer single-consumer ring in a named shared-memory segment
+#pragma once
+
+#include "core/types.hpp"
+#include "utils/shared_segment.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace nanomarket::utils {
+
+// Same algorithm and memory ordering as SpscRing, but the indices and slots live in a
+// SharedSegment so producer and consumer can be separate processes.
+//
+// Segment layout (each block on its own cache line so the two sides never false-share):
+//   header   : magic, layout version, element size, capacity (written once by the creator)
+//   producer : head index, producer pid, producer heartbeat
+//   consumer : tail index, consumer pid, consumer heartbeat
+//   slots    : N elements of T
+//
+// Either side may create the segment; the other attaches and validates the header. Each side
+// claims its role by pid, refreshes a heartbeat from its idle loop, and can ask whether the peer
+// is still alive (attached, process running, heartbeat fresh). A role held by a dead process can
+// be taken over, which lets a crashed or retired strategy be replaced without restarting the
+// matcher.
+
+inline constexpr uint32_t kShmRingMagic = 0x4E4D5352; // "RSMN"
+inline constexpr uint32_t kShmRingVersion = 1;
+
+template<typename T, size_t N>
+class ShmSpscRing {
+    static_assert((N & (N-1)) == 0, "N must be power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "T is copied across processes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be lock-free");
+public:
+    enum class Role { Producer, Consumer };
+
+    ShmSpscRing() noexcept = default;
+    ~ShmSpscRing() { detach(); }
+
+    ShmSpscRing(const ShmSpscRing&) = delete;
+    ShmSpscRing& operator=(const ShmSpscRing&) = delete;
+
+    // Create a fresh segment under `name` and claim `role`. An existing ring of that name is
+    // replaced only if it is stale: neither role is held by a running process whose heartbeat is
+    // within `stale_after_ns`. Anything else under the name (a live ring, another layout) is left
+    // alone and create fails.
+    bool create(const char* name, Role role, int64_t stale_after_ns = kDefaultStaleNs) noexcept {
+        detach();
+        if (!seg_.create(name, sizeof(Layout))) {
+            if (!stale(name, stale_after_ns) || !SharedSegment::remove(name)) return false;
+            if (!seg_.create(name, sizeof(Layout))) return false;
+        }
+        layout_ = new (seg_.data()) Layout();
+        layout_->elem_size = sizeof(T);
+        layout_->capacity = N;
+        layout_->version = kShmRingVersion;
+        layout_->magic.store(kShmRingMagic, std::memory_order_release); // publish initialised header
+        return claim(role);
+    }
+
+    // Attach to a segment created by the peer. Fails on a layout mismatch or if `role` is held by
+    // a live process.
+    bool attach(const char* name, Role role) noexcept {
+        detach();
+        if (!seg_.attach(name, sizeof(Layout))) return false;
+        layout_ = static_cast<Layout*>(seg_.data());
+        if (layout_->magic.load(std::memory_order_acquire) != kShmRingMagic ||
+            layout_->version != kShmRingVersion || layout_->elem_size != sizeof(T) || layout_->capacity != N) {
+            layout_ = nullptr;
+            seg_.close();
+            return false;
+        }
+        return claim(role);
+    }
+
+    // Release the role (the peer then sees this side as gone) and unmap.
+    void detach() noexcept {
+        if (!layout_) return;
+        Side& self = own();
+        self.heartbeat_ns.store(0, std::memory_order_relaxed);
+        self.pid.store(0, std::memory_order_release);
+        layout_ = nullptr;
+        seg_.close();
+    }
+
+    bool attached() const noexcept { return layout_ != nullptr; }
+
+    bool push(const T& item) noexcept {
+        auto& p = layout_->producer;
+        const auto head = p.index.load(std::memory_order_relaxed);
+        const auto next = (head + 1) & mask_;
+        if (next == cached_peer_) {
+            cached_peer_ = layout_->consumer.index.load(std::memory_order_acquire);
+            if (next == cached_peer_) return false; // full
+        }
+        layout_->slots[head] = item;
+        p.index.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) noexcept {
+        auto& c = layout_->consumer;
+        const auto tail = c.index.load(std::memory_order_relaxed);
+        if (tail == cached_peer_) {
+            cached_peer_ = layout_->producer.index.load(std::memory_order_acquire);
+            if (tail == cached_peer_) return false; // empty
+        }
+        out = layout_->slots[tail];
+        c.index.store((tail + 1) & mask_, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const noexcept {
+        return layout_->producer.index.load(std::memory_order_acquire) == layout_->consumer.index.load(std::memory_order_acquire);
+    }
+
+    // Refresh this side's heartbeat. Call from the idle/poll loop, not per element.
+    void heartbeat() noexcept { own().heartbeat_ns.store(core::now_ns(), std::memory_order_relaxed); }
+
+    bool peer_attached() const noexcept { return peer().pid.load(std::memory_order_acquire) != 0; }
+
+    // Peer holds its role, its process exists and (if `timeout_ns` > 0) its heartbeat is recent.
+    bool peer_alive(int64_t timeout_ns) const noexcept {
+        const Side& p = peer();
+        const uint64_t pid = p.pid.load(std::memory_order_acquire);
+        if (pid == 0 || !process_alive(pid)) return false;
+        if (timeout_ns <= 0) return true;
+        return core::now_ns() - p.heartbeat_ns.load(std::memory_order_relaxed) <= timeout_ns;
+    }
+
+    static constexpr int64_t kDefaultStaleNs = 1'000'000'000;
+
+private:
+    struct alignas(64) Side {
+        std::atomic<size_t> index{0};
+        std::atomic<uint64_t> pid{0};
+        std::atomic<int64_t> heartbeat_ns{0};
+    };
+
+    struct Layout {
+        alignas(64) std::atomic<uint32_t> magic{0};
+        uint32_t version{0};
+        uint32_t elem_size{0};
+        uint32_t capacity{0};
+        Side producer;
+        Side consumer;
+        alignas(64) T slots[N];
+    };
+
+    Side& own() noexcept { return role_ == Role::Producer ? layout_->producer : layout_->consumer; }
+    const Side& peer() const noexcept { return role_ == Role::Producer ? layout_->consumer : layout_->producer; }
+
+    static bool side_live(const Side& s, int64_t stale_after_ns) noexcept {
+        const uint64_t pid = s.pid.load(std::memory_order_acquire);
+        if (pid == 0 || !process_alive(pid)) return false;
+        return core::now_ns() - s.heartbeat_ns.load(std::memory_order_relaxed) <= stale_after_ns;
+    }
+
+    // The ring left under `name` by an earlier owner has no live holder. The header and both
+    // sides sit at the same offsets for every T and N, so any ring of this version is checked.
+    static bool stale(const char* name, int64_t stale_after_ns) noexcept {
+        SharedSegment old;
+        if (!old.attach(name, offsetof(Layout, slots))) return false;
+        const Layout* l = static_cast<const Layout*>(old.data());
+        if (l->magic.load(std::memory_order_acquire) != kShmRingMagic || l->version != kShmRingVersion) return false;
+        return !side_live(l->producer, stale_after_ns) && !side_live(l->consumer, stale_after_ns);
+    }
+
+    bool claim(Role role) noexcept {
+        role_ = role;
+        Side& self = own();
+        const uint64_t me = current_pid();
+        uint64_t holder = self.pid.load(std::memory_order_acquire);
+        // Take over a role whose holder has exited without detaching.
+        if (holder != 0 && holder != me && process_alive(holder)) {
+            layout_ = nullptr;
+            seg_.close();
+            return false;
+        }
+        if (!self.pid.compare_exchange_strong(holder, me, std::memory_order_acq_rel)) {
+            layout_ = nullptr;
+            seg_.close();
+            return false;
+        }
+        self.heartbeat_ns.store(core::now_ns(), std::memory_order_relaxed);
+        // Start from the peer's current index so a replacement process sees a consistent ring.
+        cached_peer_ = peer().index.load(std::memory_order_acquire);
+        return true;
+    }
+
+    static constexpr size_t mask_ = N - 1;
+    SharedSegment seg_;
+    Layout* layout_ = nullptr;
+    Role role_ = Role::Consumer;
+    size_t cached_peer_ = 0; // last observed peer index; refreshed only when the ring looks full/empty
+};
+
+} // namespace nanomarket::utils
@@ -0,0 +1,240 @@
+#include "backtest/exchange_sim.hpp"
+#include "risk/risk.hpp"
+
+#include <algorithm>
+#include <memory>
+
+using namespace nanomarket::core;
+namespace mb = nanomarket::backtest;
+namespace em = nanomarket::exchange;
+namespace ms = nanomarket::strategy;
+
+namespace {
+
+// Participant ids are disjoint from tape ids and from each other: base + (participant << 40).
+constexpr OrderId kSimIdBase = OrderId{1} << 62;
+constexpr int kParticipantIdShift = 40;
+constexpr uint32_t kTape = 0xFFFFFFFFu;
+constexpr size_t kMaxExecs = 64;
+
+uint64_t splitmix64(uint64_t& state) noexcept {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+enum class Kind : uint8_t {
+    Tape,      // next tape order reaches the engine
+    Arrive,    // participant order reaches the engine
+    Match,     // engine finished servicing an order: apply it to the book
+    Trade,     // public trade print delivered to a participant
+    Top,       // top-of-book tick delivered to a participant
+    Ack,       // private: order accepted, `filled` executed immediately
+    Reject,    // private: order refused by risk
+};
+
+struct Event {
+    Kind kind = Kind::Tape;
+    Side side = Side::Buy;    // Trade: side of the incoming order
+    uint32_t participant = 0; // owner of the order, or recipient of a delivery; kTape for tape orders
+    Qty filled = 0;
+    union Payload {
+        em::Order order;
+        em::Execution exec;
+        em::OrderBook::TopOfBook top;
+        Payload() noexcept : exec{} {}
+    } u;
+};
+
+struct Participant {
+    Participant(const mb::ParticipantConfig& c, Price ref_price, OrderId id_base, uint64_t seed)
+        : cfg(c), quoter(c.quoter, ref_price, id_base), rng(seed) {}
+
+    mb::ParticipantConfig cfg;
+    ms::Quoter quoter;
+    nanomarket::risk::RiskEngine risk;
+    uint64_t rng;
+    Timestamp entry_last = 0; // last delivery on the order-entry channel
+    Timestamp md_last = 0;    // last delivery on the market-data channel
+    uint32_t in_flight = 0;   // orders sent and not yet acknowledged or rejected
+};
+
+class Simulator {
+public:
+    Simulator(const std::vector<em::Order>& tape, const std::vector<mb::ParticipantConfig>& parts,
+              const mb::SimConfig& cfg)
+        : tape_(tape), cfg_(cfg), book_(cfg.book), wheel_(cfg.max_in_flight), engine_rng_(cfg.seed) {
+        parts_.reserve(parts.size());
+        for (size_t i = 0; i < parts.size(); ++i) {
+            uint64_t s = cfg.seed ^ (0xD1B54A32D192ED03ULL * (i + 1));
+            auto p = std::make_unique<Participant>(parts[i], cfg.book.ref_price,
+                                                   kSimIdBase + (OrderId{i} << kParticipantIdShift), splitmix64(s));
+            p->risk.limits().max_position = cfg.max_position;
+            p->risk.limits().max_order_size = cfg.max_order_size;
+            p->risk.limits().max_notional = cfg.max_notional;
+            parts_.push_back(std::move(p));
+        }
+    }
+
+    mb::SimResult run() {
+        schedule_tape();
+        Timestamp at = 0;
+        Event ev;
+        while (wheel_.pop(at, ev)) {
+            ++stats_.events;
+            switch (ev.kind) {
+            case Kind::Tape:
+                ++stats_.tape_orders;
+                enter_engine(ev);
+                schedule_tape();
+                break;
+            case Kind::Arrive: enter_engine(ev); break;
+            case Kind::Match: match(ev); break;
+            default: deliver(ev); break;
+            }
+        }
+        stats_.end_ns = wheel_.now();
+
+        mb::SimResult r;
+        r.participants.reserve(parts_.size());
+        for (const auto& p : parts_) r.participants.push_back(p->quoter.summary());
+        r.stats = stats_;
+        return r;
+    }
+
+private:
+    void push(Timestamp at, const Event& ev) noexcept {
+        if (!wheel_.schedule(at, ev)) { ++stats_.dropped; return; }
+        stats_.peak_in_flight = std::max(stats_.peak_in_flight, wheel_.size());
+    }
+
+    void schedule_tape() noexcept {
+        if (next_tape_ >= tape_.size()) return;
+        Event ev;
+        ev.kind = Kind::Tape;
+        ev.participant = kTape;
+        ev.u.order = tape_[next_tape_++];
+        push(ev.u.order.ts * cfg_.tape_time_scale, ev);
+    }
+
+    // Single-server FIFO engine: service starts when the previous order is done.
+    void enter_engine(Event ev) noexcept {
+        const Timestamp now = wheel_.now();
+        const Timestamp start = std::max(now, engine_free_);
+        stats_.max_queue_ns = std::max<int64_t>(stats_.max_queue_ns, start - now);
+        engine_free_ = start + cfg_.matching.sample(engine_rng_);
+        ev.kind = Kind::Match;
+        push(engine_free_, ev);
+    }
+
+    void match(const Event& ev) noexcept {
+        const em::Order& o = ev.u.order;
+        Participant* owner = ev.participant == kTape ? nullptr : parts_[ev.participant].get();
+        if (owner && !owner->risk.check_new_order(o.price, o.qty, o.side)) {
+            ++stats_.rejects;
+            Event r = ev;
+            r.kind = Kind::Reject;
+            send(ev.participant, r);
+            return;
+        }
+
+        const size_t n = std::min(book_.submit_order(o, execs_, kMaxExecs), kMaxExecs);
+        Qty filled = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const em::Execution& e = execs_[i];
+            filled += e.filled_qty;
+            ++stats_.executions;
+            if (owner) owner->risk.on_fill(e.price, e.filled_qty, o.side);
+            if (Participant* rest = owner_of(e.resting_id))
+                rest->risk.on_fill(e.price, e.filled_qty, o.side == Side::Buy ? Side::Sell : Side::Buy);
+            Event t;
+            t.kind = Kind::Trade;
+            t.side = o.side;
+            t.u.exec = e;
+            for (uint32_t p = 0; p < parts_.size(); ++p) send(p, t);
+        }
+
+        if (owner) {
+            Event a = ev;
+            a.kind = Kind::Ack;
+            a.filled = filled;
+            send(ev.participant, a);
+        } else {
+            // Market-data tick after each tape order; participants react to these.
+            Event t;
+            t.kind = Kind::Top;
+            t.u.top = book_.top_of_book();
+            for (uint32_t p = 0; p < parts_.size(); ++p) send(p, t);
+        }
+    }
+
+    // Engine -> participant, in order on the participant's market-data channel.
+    void send(uint32_t p, Event ev) noexcept {
+        Participant& part = *parts_[p];
+        const Timestamp at = std::max(wheel_.now() + part.cfg.market_data.sample(part.rng), part.md_last);
+        part.md_last = at;
+        ev.participant = p;
+        push(at, ev);
+    }
+
+    void deliver(const Event& ev) noexcept {
+        Participant& part = *parts_[ev.participant];
+        switch (ev.kind) {
+        case Kind::Trade: part.quoter.on_execution(ev.u.exec, ev.side); break;
+        case Kind::Ack: part.quoter.on_submitted(ev.u.order, ev.filled); --part.in_flight; break;
+        case Kind::Reject: part.quoter.on_rejected(ev.u.order); --part.in_flight; break;
+        case Kind::Top: if (part.in_flight == 0) requote(ev.participant, ev.u.top); break;
+        default: break;
+        }
+    }
+
+    void requote(uint32_t p, const em::OrderBook::TopOfBook& top) noexcept {
+        Participant& part = *parts_[p];
+        em::Order quotes[2];
+        const size_t n = part.quoter.requote(top, wheel_.now(), quotes);
+        for (size_t k = 0; k < n; ++k) {
+            const Timestamp at = std::max(wheel_.now() + part.cfg.order_entry.sample(part.rng), part.entry_last);
+            part.entry_last = at;
+            Event ev;
+            ev.kind = Kind::Arrive;
+            ev.participant = p;
+            ev.u.order = quotes[k];
+            ++part.in_flight;
+            ++stats_.participant_orders;
+            push(at, ev);
+        }
+    }
+
+    Participant* owner_of(OrderId id) const noexcept {
+        if (id < kSimIdBase) return nullptr;
+        const OrderId p = (id - kSimIdBase) >> kParticipantIdShift;
+        return p < parts_.size() ? parts_[p].get() : nullptr;
+    }
+
+    const std::vector<em::Order>& tape_;
+    const mb::SimConfig& cfg_;
+    em::OrderBook book_;
+    mb::TimingWheel<Event> wheel_;
+    std::vector<std::unique_ptr<Participant>> parts_;
+    uint64_t engine_rng_;
+    Timestamp engine_free_ = 0;
+    size_t next_tape_ = 0;
+    em::Execution execs_[kMaxExecs];
+    mb::SimStats stats_;
+};
+
+} // namespace
+
+Timestamp mb::LatencyModel::sample(uint64_t& rng) const noexcept {
+    Timestamp t = base_ns;
+    if (jitter_ns > 0) t += static_cast<Timestamp>(splitmix64(rng) % static_cast<uint64_t>(jitter_ns + 1));
+    if (spike_ppm > 0 && splitmix64(rng) % 1000000 < spike_ppm) t += spike_ns;
+    return t;
+}
+
+mb::SimResult mb::run_exchange_sim(const std::vector<em::Order>& tape, const std::vector<ParticipantConfig>& participants,
+                                   const SimConfig& cfg) {
+    auto sim = std::make_unique<Simulator>(tape, participants, cfg);
+    return sim->run();
+}
@@ -0,0 +1,112 @@
+#include "backtest/param_sweep.hpp"
+#include "core/types.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+using namespace nanomarket::core;
+namespace mb = nanomarket::backtest;
+namespace em = nanomarket::exchange;
+namespace ms = nanomarket::strategy;
+
+namespace {
+
+// Quoter ids start high enough never to collide with tape order ids.
+constexpr OrderId kQuoterIdBase = OrderId{1} << 62;
+constexpr size_t kMaxExecs = 64;
+
+class Instance {
+public:
+    Instance(const ms::Quoter::Settings& s, const mb::SweepConfig& cfg)
+        : book_(cfg.book), quoter_(s, cfg.book.ref_price, kQuoterIdBase) {
+        risk_.limits().max_position = cfg.max_position;
+        risk_.limits().max_order_size = cfg.max_order_size;
+        risk_.limits().max_notional = cfg.max_notional;
+    }
+
+    void on_event(const em::Order& o) noexcept {
+        size_t n = std::min(book_.submit_order(o, execs_, kMaxExecs), kMaxExecs);
+        for (size_t i = 0; i < n; ++i) account(execs_[i], o.side);
+
+        em::Order quotes[2];
+        size_t nq = quoter_.requote(book_.top_of_book(), o.ts, quotes);
+        for (size_t k = 0; k < nq; ++k) {
+            const em::Order& q = quotes[k];
+            if (!risk_.check_new_order(q.price, q.qty, q.side)) { quoter_.on_rejected(q); continue; }
+            size_t m = std::min(book_.submit_order(q, execs_, kMaxExecs), kMaxExecs);
+            Qty filled = 0;
+            for (size_t i = 0; i < m; ++i) { account(execs_[i], q.side); filled += execs_[i].filled_qty; }
+            quoter_.on_submitted(q, filled);
+        }
+    }
+
+    mb::SweepResult result() const { return mb::SweepResult{quoter_.settings(), quoter_.summary()}; }
+
+private:
+    void account(const em::Execution& e, Side incoming_side) noexcept {
+        const bool ours_in = quoter_.owns(e.incoming_id);
+        const bool ours_rest = quoter_.owns(e.resting_id);
+        quoter_.on_execution(e, incoming_side);
+        if (ours_in) risk_.on_fill(e.price, e.filled_qty, incoming_side);
+        if (ours_rest) risk_.on_fill(e.price, e.filled_qty, incoming_side == Side::Buy ? Side::Sell : Side::Buy);
+    }
+
+    em::OrderBook book_;
+    nanomarket::risk::RiskEngine risk_;
+    ms::Quoter quoter_;
+    em::Execution execs_[kMaxExecs];
+};
+
+} // namespace
+
+std::vector<ms::Quoter::Settings> mb::make_grid(const std::vector<int32_t>& spreads,
+                                                const std::vector<int32_t>& sizes,
+                                                const std::vector<int32_t>& max_sizes) {
+    std::vector<ms::Quoter::Settings> grid;
+    grid.reserve(spreads.size() * sizes.size() * max_sizes.size());
+    for (int32_t sp : spreads)
+        for (int32_t sz : sizes)
+            for (int32_t mx : max_sizes) grid.push_back(ms::Quoter::Settings{sp, sz, mx});
+    return grid;
+}
+
+mb::SweepResult mb::run_single(const std::vector<em::Order>& tape, const ms::Quoter::Settings& s,
+                               const SweepConfig& cfg) {
+    auto inst = std::make_unique<Instance>(s, cfg);
+    for (const em::Order& o : tape) inst->on_event(o);
+    return inst->result();
+}
+
+std::vector<mb::SweepResult> mb::run_sweep(const std::vector<em::Order>& tape,
+                                           const std::vector<ms::Quoter::Settings>& grid,
+                                           const SweepConfig& cfg) {
+    std::vector<std::unique_ptr<Instance>> instances;
+    instances.reserve(grid.size());
+    for (const auto& s : grid) instances.push_back(std::make_unique<Instance>(s, cfg));
+
+    unsigned threads = cfg.threads ? cfg.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(instances.size(), 1)));
+    const size_t batch = std::max<size_t>(cfg.batch_events, 1);
+
+    // Thread t owns instances t, t + threads, ... (no shared mutable state between threads).
+    auto worker = [&](unsigned t) {
+        for (size_t begin = 0; begin < tape.size(); begin += batch) {
+            const size_t end = std::min(begin + batch, tape.size());
+            for (size_t k = t; k < instances.size(); k += threads) {
+                Instance& inst = *instances[k];
+                for (size_t i = begin; i < end; ++i) inst.on_event(tape[i]);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    std::vector<SweepResult> results;
+    results.reserve(instances.size());
+    for (const auto& inst : instances) results.push_back(inst->result());
+    return results;
+}
@@ -0,0 +1,128 @@
+#include "core/types.hpp"
+#include "exchange/order_book.hpp"
+#include "risk/risk.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace nanomarket::core;
+namespace em = nanomarket::exchange;
+
+// Usage: book_bench [orders] [max_orders] [levels]
+// Throughput of risk check + matching for one-at-a-time submission versus
+// RiskEngine::prepare_batch + OrderBook::submit_batch at batch sizes 1..256, on a synthetic tape.
+// Modes run interleaved and the best of several rounds is reported, to damp machine noise.
+// Every mode must produce the same executions; the checksum column shows it.
+
+namespace {
+
+struct Run {
+    double mops = 0.0;
+    uint64_t checksum = 0;
+};
+
+void set_limits(nanomarket::risk::RiskEngine& risk) {
+    risk.limits().max_position = 1LL << 40;
+    risk.limits().max_order_size = 1000;
+    risk.limits().max_notional = 1LL << 60;
+}
+
+uint64_t mix(uint64_t h, const em::Execution& e) {
+    return (h ^ (e.resting_id * 31 + e.incoming_id * 17 + static_cast<uint64_t>(e.filled_qty))) * 0x100000001B3ULL;
+}
+
+Run run_sequential(const std::vector<em::Order>& tape, const em::OrderBook::Config& cfg) {
+    auto book = std::make_unique<em::OrderBook>(cfg);
+    nanomarket::risk::RiskEngine risk;
+    set_limits(risk);
+    em::Execution out[em::OrderBook::kBatchMaxExecs];
+    Run r;
+    const int64_t t0 = now_ns();
+    for (const em::Order& o : tape) {
+        if (!risk.check_new_order(o.price, o.qty, o.side)) continue;
+        const size_t n = std::min(book->submit_order(o, out, em::OrderBook::kBatchMaxExecs), em::OrderBook::kBatchMaxExecs);
+        for (size_t i = 0; i < n; ++i) {
+            risk.on_fill(out[i].price, out[i].filled_qty, o.side);
+            r.checksum = mix(r.checksum, out[i]);
+        }
+    }
+    r.mops = static_cast<double>(tape.size()) * 1e3 / static_cast<double>(now_ns() - t0);
+    return r;
+}
+
+Run run_batched(const std::vector<em::Order>& tape, const em::OrderBook::Config& cfg, size_t batch) {
+    auto book = std::make_unique<em::OrderBook>(cfg);
+    nanomarket::risk::RiskEngine risk;
+    set_limits(risk);
+    nanomarket::risk::BatchTerms terms;
+    Run r;
+    const int64_t t0 = now_ns();
+    for (size_t base = 0; base < tape.size(); base += batch) {
+        const std::span<const em::Order> orders(tape.data() + base, std::min(batch, tape.size() - base));
+        risk.prepare_batch(orders, terms);
+        book->submit_batch(
+            orders, [&](size_t i, const em::Order&) { return risk.check_prepared(terms, i); },
+            [&](size_t, const em::Order& o, bool, const em::Execution* out, size_t n) {
+                for (size_t i = 0; i < n; ++i) {
+                    risk.on_fill(out[i].price, out[i].filled_qty, o.side);
+                    r.checksum = mix(r.checksum, out[i]);
+                }
+            });
+    }
+    r.mops = static_cast<double>(tape.size()) * 1e3 / static_cast<double>(now_ns() - t0);
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    em::OrderBook::Config cfg{1, 64, 1 << 18, 10000};
+    if (argc >= 3) cfg.max_orders = std::atoi(argv[2]);
+    if (argc >= 4) cfg.levels = std::atoi(argv[3]);
+
+    // Random buy/sell flow around the reference price with occasional large sweeping orders.
+    std::vector<em::Order> tape(count);
+    uint64_t x = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        em::Order& o = tape[i];
+        o.id = i + 1;
+        o.side = ((x >> 33) & 1) ? Side::Buy : Side::Sell;
+        o.price = cfg.ref_price - cfg.levels / 2 + static_cast<Price>((x >> 40) % static_cast<uint64_t>(cfg.levels));
+        o.qty = 1 + static_cast<Qty>((x >> 52) % ((i % 64 == 0) ? 50 : 8));
+        o.remaining = o.qty;
+        o.ts = static_cast<Timestamp>(i + 1);
+    }
+
+    constexpr int kRounds = 9;
+    constexpr size_t kModes = 10; // sequential, then batch 1, 2, 4, ..., 256
+    Run best[kModes];
+    for (int round = 0; round < kRounds; ++round) {
+        for (size_t m = 0; m < kModes; ++m) {
+            const Run r = m == 0 ? run_sequential(tape, cfg) : run_batched(tape, cfg, size_t{1} << (m - 1));
+            if (round == 0 || r.mops > best[m].mops) best[m] = r;
+        }
+    }
+
+    std::printf("%-10s %10s %8s %18s\n", "mode", "Morders/s", "speedup", "checksum");
+    bool identical = true;
+    for (size_t m = 0; m < kModes; ++m) {
+        char name[16];
+        if (m == 0) std::snprintf(name, sizeof(name), "sequential");
+        else std::snprintf(name, sizeof(name), "batch %zu", size_t{1} << (m - 1));
+        std::printf("%-10s %10.2f %8.2f %18llx\n", name, best[m].mops, best[m].mops / best[0].mops,
+                    (unsigned long long)best[m].checksum);
+        identical = identical && best[m].checksum == best[0].checksum;
+    }
+    if (!identical) {
+        std::cerr << "batched executions differ from sequential submission\n";
+        return 1;
+    }
+    return 0;
+}
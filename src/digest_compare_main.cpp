@@ -0,0 +1,36 @@
+#include "exchange/replay_digest.hpp"
+
+#include <iostream>
+#include <vector>
+
+// Compare two replay digests (main_replay --digest) and report the first divergent event range.
+// Usage: digest_compare <expected.digest> <actual.digest>
+// Exit code: 0 identical, 1 diverged, 2 usage/IO error.
+
+int main(int argc, char** argv) {
+    using nanomarket::exchange::ReplayDigest;
+    if (argc < 3) {
+        std::cerr << "Usage: digest_compare <expected.digest> <actual.digest>\n";
+        return 2;
+    }
+
+    uint64_t ia = 0, ib = 0;
+    std::vector<ReplayDigest::Checkpoint> a, b;
+    if (!ReplayDigest::load(argv[1], ia, a)) { std::cerr << "Cannot read digest " << argv[1] << "\n"; return 2; }
+    if (!ReplayDigest::load(argv[2], ib, b)) { std::cerr << "Cannot read digest " << argv[2] << "\n"; return 2; }
+    if (ia != ib) {
+        std::cerr << "Checkpoint intervals differ (" << ia << " vs " << ib << "); re-run with the same --digest-every\n";
+        return 2;
+    }
+
+    auto d = ReplayDigest::compare(a, b);
+    if (!d.diverged) {
+        std::cout << "identical: " << (a.empty() ? 0 : a.back().events) << " events, " << a.size() << " checkpoints\n";
+        return 0;
+    }
+    std::cout << "diverged at checkpoint " << d.checkpoint << ": events [" << d.first_event << ", " << d.end_event << ")\n";
+    if (d.end_event - d.first_event > 1) {
+        std::cout << "narrow it down by re-running both builds with --digest-every " << (ia > 16 ? ia / 16 : 1) << "\n";
+    }
+    return 1;
+}
@@ -1,59 +1,67 @@
 #include "exchange/market_replayer.hpp"
 #include "core/types.hpp"
 #include "exchange/order.hpp"
+#include "exchange/replay_format.hpp"
+#include "feed/feed_publisher.hpp"
 
-#include <cstring>
 #include <cstdlib>
 
 using namespace nanomarket::core;
 namespace em = nanomarket::exchange;
 
 em::MarketDataReplayer::MarketDataReplayer(const Config& cfg, OrderBook& book, nanomarket::risk::RiskEngine& risk) noexcept
-    : cfg_(cfg), book_(book), risk_(risk), logical_ts_(1), logf_(nullptr) {
-    if (fopen_s(&logf_, cfg_.outfile, "w") != 0) logf_ = nullptr;
+    : cfg_(cfg), book_(book), risk_(risk), logf_(nullptr) {
+    if (cfg_.outfile && fopen_s(&logf_, cfg_.outfile, "w") != 0) logf_ = nullptr;
 }
 
 em::MarketDataReplayer::~MarketDataReplayer() {
     if (logf_) std::fclose(logf_);
 }
 
-bool em::MarketDataReplayer::parse_line(char* buf, Order& out) noexcept {
-    // CSV format: ORDER,id,side(B|S),price,qty[,ts]
-    // Example: ORDER,1,B,10002,5,10
-    // We operate in-place over the buffer to avoid allocations.
-    char* ctx = nullptr;
-    char* tok = strtok_s(buf, ",\n\r", &ctx);
-    if (!tok) return false;
-    if (std::strcmp(tok, "ORDER") != 0) return false;
-
-    // id
-    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
-    out.id = static_cast<OrderId>(std::strtoull(tok, nullptr, 10));
-
-    // side
-    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
-    out.side = (tok[0] == 'B') ? Side::Buy : Side::Sell;
-
-    // price
-    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
-    out.price = static_cast<Price>(std::strtoll(tok, nullptr, 10));
-
-    // qty
-    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
-    out.qty = static_cast<Qty>(std::strtol(tok, nullptr, 10));
-    out.remaining = out.qty;
-
-    // optional ts
-    tok = strtok_s(nullptr, ",\n\r", &ctx);
-    if (tok) {
-        out.ts = static_cast<Timestamp>(std::strtoll(tok, nullptr, 10));
-        logical_ts_ = out.ts + 1;
-    } else {
-        out.ts = logical_ts_++;
+void em::MarketDataReplayer::publish_feed(const Order& o, const Execution* execs, size_t n, Qty rested) noexcept {
+    for (size_t i = 0; i < n; ++i) cfg_.feed->on_execution(execs[i], o.side);
+    // Whatever the book reports resting, not o.qty minus the reported fills: those are capped at
+    // the execution buffer, and a full order pool rests nothing.
+    if (rested > 0) cfg_.feed->on_add(o, rested);
+
+    const OrderBook::TopOfBook top = book_.top_of_book();
+    if (!(top == last_top_)) {
+        cfg_.feed->on_top_of_book(top, o.ts);
+        last_top_ = top;
+    }
+}
+
+void em::MarketDataReplayer::process_event(const Order& o, Execution* out_execs) noexcept {
+    // Risk check
+    bool ok = risk_.check_new_order(o.price, o.qty, o.side);
+    if (!ok) {
+        if (logf_) write_reject(logf_, o);
+        if (cfg_.digest) { cfg_.digest->on_reject(o); cfg_.digest->end_event(); }
+        return;
     }
 
-    out.next = -1;
-    return true;
+    // Submit to order book using caller-provided buffer (no heap)
+    Qty rested = 0;
+    size_t n = book_.submit_order(o, out_execs, 64, &rested);
+    if (n > 64) n = 64; // only the first 64 were written
+    for (size_t i = 0; i < n; ++i) {
+        auto &e = out_execs[i];
+        risk_.on_fill(e.price, e.filled_qty, (o.side==Side::Buy)?Side::Buy:Side::Sell);
+        if (cfg_.digest) cfg_.digest->on_execution(e);
+        if (cfg_.snapshots) cfg_.snapshots->on_execution(e);
+        if (logf_) write_execution(logf_, e);
+    }
+    if (cfg_.feed) publish_feed(o, out_execs, n, rested);
+
+    // Log deterministic risk snapshot after processing this tick using atomic readers.
+    // Acquire ordering in readers ensures a consistent view of incremental updates
+    // without blocking or locks. These reads are cheap and safe for single-threaded
+    // replay; they are also safe to call from other threads for monitoring.
+    int64_t pos = risk_.position();
+    int64_t notl = risk_.notional();
+    if (logf_) write_risk(logf_, o.ts, pos, notl);
+    if (cfg_.digest) { cfg_.digest->on_risk(o.ts, pos, notl); cfg_.digest->end_event(); }
+    if (cfg_.snapshots) cfg_.snapshots->publish(book_, risk_, o.ts);
 }
 
 int em::MarketDataReplayer::run() noexcept {
@@ -66,35 +74,51 @@ int em::MarketDataReplayer::run() noexcept {
     Order o;
     Execution out_execs[64];
 
-    while (std::fgets(line, sizeof(line), f)) {
-        if (!parse_line(line, o)) continue;
-
-        // Per-tick measurement (optional)
-        nanomarket::latency::ScopedTimer t("replay_tick");
+    const bool paced = cfg_.speed > 0.0;
+    paced_ = PacedStats{};
+    size_t seconds_used = 0;
+    if (paced) {
+        pacer_.calibrate();
+        paced_.per_second.assign(kMaxPacedSeconds, 0); // no allocation once events flow
+    }
+    bool first = true;
+    Timestamp first_ts = 0, last_ts = 0;
+    int64_t wall_start = 0;
 
-        // Risk check
-        bool ok = risk_.check_new_order(o.price, o.qty, o.side);
-        if (!ok) {
-            std::fprintf(logf_, "TS=%lld,ORDER=%llu,%c,REJECTED\n", (long long)o.ts, (unsigned long long)o.id, (o.side==Side::Buy)?'B':'S');
+    while (std::fgets(line, sizeof(line), f)) {
+        if (!decoder_.parse_line(line, o)) continue;
+        if (!paced) {
+            // Per-tick measurement (optional)
+            nanomarket::latency::ScopedTimer t("replay_tick");
+            process_event(o, out_execs);
             continue;
         }
 
-        // Submit to order book using caller-provided buffer (no heap)
-        size_t n = book_.submit_order(o, out_execs, 64);
-        for (size_t i = 0; i < n; ++i) {
-            auto &e = out_execs[i];
-            risk_.on_fill(e.price, e.filled_qty, (o.side==Side::Buy)?Side::Buy:Side::Sell);
-            std::fprintf(logf_, "TS=%lld,EXEC,rest=%llu,in=%llu,qty=%d,px=%lld\n", (long long)e.ts, (unsigned long long)e.resting_id, (unsigned long long)e.incoming_id, (int)e.filled_qty, (long long)e.price);
-        }
-
-        // Log deterministic risk snapshot after processing this tick using atomic readers.
-        // Acquire ordering in readers ensures a consistent view of incremental updates
-        // without blocking or locks. These reads are cheap and safe for single-threaded
-        // replay; they are also safe to call from other threads for monitoring.
-        int64_t pos = risk_.position();
-        int64_t notl = risk_.notional();
-        std::fprintf(logf_, "TS=%lld,RISK,position=%lld,notional=%lld\n", (long long)o.ts, (long long)pos, (long long)notl);
+        // Open loop: the schedule comes from the tape alone, never from when the previous event
+        // finished. Timestamps that step backwards are held at the latest one seen.
+        if (first) { first = false; first_ts = last_ts = o.ts; wall_start = core::now_ns(); }
+        if (o.ts > last_ts) last_ts = o.ts;
+        const double offset_ns = static_cast<double>(last_ts - first_ts) * static_cast<double>(cfg_.tape_time_scale);
+        const int64_t scheduled = wall_start + static_cast<int64_t>(offset_ns / cfg_.speed);
+        const int64_t start = pacer_.wait_until(scheduled);
+        process_event(o, out_execs);
+        const int64_t end = core::now_ns();
+
+        paced_.latency.record(end - scheduled);
+        paced_.service.record(end - start);
+        if (start - scheduled > paced_.max_lag_ns) paced_.max_lag_ns = start - scheduled;
+        size_t sec = static_cast<size_t>((end - wall_start) / 1'000'000'000);
+        if (sec >= kMaxPacedSeconds) sec = kMaxPacedSeconds - 1;
+        ++paced_.per_second[sec];
+        if (sec >= seconds_used) seconds_used = sec + 1;
+        // No per-tick "replay_tick" sample here: the histograms already hold it, and a sample
+        // file write stalling on a buffer flush would delay the next release.
     }
+    if (paced && !first) paced_.wall_ns = core::now_ns() - wall_start;
+    if (paced) paced_.per_second.resize(seconds_used);
+
+    if (cfg_.digest) cfg_.digest->finish();
+    if (logf_) std::fflush(logf_);
 
     std::fclose(f);
     return 0;
@@ -0,0 +1,22 @@
+#include "exchange/market_snapshot.hpp"
+#include "core/types.hpp"
+
+using namespace nanomarket::core;
+namespace em = nanomarket::exchange;
+
+void em::SnapshotPublisher::publish(const OrderBook& book, const nanomarket::risk::RiskEngine& risk, core::Timestamp ts) noexcept {
+    MarketSnapshot s;
+    s.batch = ++batch_;
+    s.ts = ts;
+    s.bid_levels = static_cast<uint32_t>(book.depth(Side::Buy, s.bids, MarketSnapshot::kDepth));
+    s.ask_levels = static_cast<uint32_t>(book.depth(Side::Sell, s.asks, MarketSnapshot::kDepth));
+    if (has_trade_) {
+        s.last_trade_px = last_trade_.price;
+        s.last_trade_qty = last_trade_.filled_qty;
+        s.last_trade_ts = last_trade_.ts;
+    }
+    // The matching thread is the only writer of risk state, so these two reads are coherent.
+    s.position = risk.position();
+    s.notional = risk.notional();
+    lock_.store(s);
+}
@@ -1,4 +1,5 @@
 #include "exchange/order_book.hpp"
+#include "core/prefetch.hpp"
 #include "core/types.hpp"
 
 #include <algorithm>
@@ -46,9 +47,54 @@ int32_t em::OrderBook::price_to_level(core::Price p) const noexcept {
     return static_cast<int32_t>(lvl);
 }
 
-size_t em::OrderBook::submit_order(const Order& o, Execution* out, size_t max_out) noexcept {
+void em::OrderBook::resolve_levels(const Order* orders, size_t n, int32_t* levels) const noexcept {
+    // Same arithmetic as price_to_level, written branch-free so the loop vectorizes.
+    const int64_t step = cfg_.tick;
+    const int64_t half = cfg_.levels / 2;
+    const int64_t top = cfg_.levels - 1;
+    for (size_t i = 0; i < n; ++i) {
+        int64_t lvl = (orders[i].price - cfg_.ref_price) / step + half;
+        lvl = lvl < 0 ? 0 : lvl;
+        lvl = lvl > top ? top : lvl;
+        levels[i] = static_cast<int32_t>(lvl);
+    }
+}
+
+em::OrderBook::FirstLevels em::OrderBook::first_levels() const noexcept {
+    FirstLevels first{-1, -1};
+    for (int32_t lvl = 0; lvl < cfg_.levels && first.bid == -1; ++lvl) if (bids_[lvl] != -1) first.bid = lvl;
+    for (int32_t lvl = 0; lvl < cfg_.levels && first.ask == -1; ++lvl) if (asks_[lvl] != -1) first.ask = lvl;
+    return first;
+}
+
+void em::OrderBook::prefetch_for(const Order& o, int32_t level, FirstLevels& first) const noexcept {
+    // Matching starts at the first non-empty opposite level (index 0 upward); a residual is
+    // appended to its own level's list from the head. A hint emptied by earlier fills is moved
+    // up a few levels, then dropped until the next chunk rescans.
+    const std::vector<int32_t>& opp = (o.side == Side::Buy) ? asks_ : bids_;
+    const std::vector<int32_t>& own = (o.side == Side::Buy) ? bids_ : asks_;
+    int32_t& hint = (o.side == Side::Buy) ? first.ask : first.bid;
+    for (int32_t probe = 0; hint != -1 && opp[hint] == -1; ++probe)
+        hint = (probe < kHintProbe && hint + 1 < cfg_.levels) ? hint + 1 : -1;
+    if (hint != -1) NANOMARKET_PREFETCH(&pool_[opp[hint]]);
+    const int32_t own_head = own[level];
+    if (own_head != -1) NANOMARKET_PREFETCH(&pool_[own_head]);
+}
+
+void em::OrderBook::note_rested(const Order& o, int32_t level, FirstLevels& first) const noexcept {
+    int32_t& hint = (o.side == Side::Buy) ? first.bid : first.ask;
+    const std::vector<int32_t>& own = (o.side == Side::Buy) ? bids_ : asks_;
+    if (o.price != 0 && (hint == -1 || level < hint) && own[level] != -1) hint = level;
+}
+
+size_t em::OrderBook::submit_order(const Order& o, Execution* out, size_t max_out, Qty* rested) noexcept {
+    return submit_resolved(o, -1, out, max_out, rested);
+}
+
+size_t em::OrderBook::submit_resolved(const Order& o, int32_t level, Execution* out, size_t max_out, Qty* rested) noexcept {
     // Single-threaded deterministic matching loop; write executions into caller buffer
     size_t produced = 0;
+    if (rested) *rested = 0;
 
     bool is_market = (o.price == 0);
     int incoming_remaining = o.qty;
@@ -120,7 +166,8 @@ size_t em::OrderBook::submit_order(const Order& o, Execution* out, size_t max_ou
         resting.ts = o.ts;
         int32_t idx = alloc_order(resting);
         if (idx >= 0) {
-            int lvl = price_to_level(resting.price);
+            if (rested) *rested = resting.qty;
+            int lvl = level >= 0 ? level : price_to_level(resting.price);
             int32_t head = (o.side == Side::Buy) ? bids_[lvl] : asks_[lvl];
             if (head == -1) {
                 if (o.side == Side::Buy) bids_[lvl] = idx; else asks_[lvl] = idx;
@@ -156,3 +203,49 @@ bool em::OrderBook::cancel(core::OrderId id) noexcept {
     }
     return false;
 }
+
+em::OrderBook::TopOfBook em::OrderBook::top_of_book() const noexcept {
+    TopOfBook top;
+    // Higher level index means higher price. Edge levels are clamped, so a level may hold
+    // several prices; report the best price within the level and the quantity at it.
+    for (int lvl = static_cast<int>(bids_.size()) - 1; lvl >= 0; --lvl) {
+        if (bids_[lvl] == -1) continue;
+        for (int32_t cur = bids_[lvl]; cur != -1; cur = pool_[cur].next) {
+            const Order& r = pool_[cur];
+            if (top.bid_qty == 0 || r.price > top.bid_px) { top.bid_px = r.price; top.bid_qty = r.remaining; }
+            else if (r.price == top.bid_px) top.bid_qty += r.remaining;
+        }
+        break;
+    }
+    for (int lvl = 0; lvl < static_cast<int>(asks_.size()); ++lvl) {
+        if (asks_[lvl] == -1) continue;
+        for (int32_t cur = asks_[lvl]; cur != -1; cur = pool_[cur].next) {
+            const Order& r = pool_[cur];
+            if (top.ask_qty == 0 || r.price < top.ask_px) { top.ask_px = r.price; top.ask_qty = r.remaining; }
+            else if (r.price == top.ask_px) top.ask_qty += r.remaining;
+        }
+        break;
+    }
+    return top;
+}
+
+size_t em::OrderBook::depth(core::Side side, DepthLevel* out, size_t max_levels) const noexcept {
+    const std::vector<int32_t>& ladder = (side == Side::Buy) ? bids_ : asks_;
+    const int n = static_cast<int>(ladder.size());
+    size_t written = 0;
+    // bids are best at the highest level index, asks at the lowest
+    for (int i = 0; i < n && written < max_levels; ++i) {
+        const int lvl = (side == Side::Buy) ? n - 1 - i : i;
+        if (ladder[lvl] == -1) continue;
+        DepthLevel d;
+        for (int32_t cur = ladder[lvl]; cur != -1; cur = pool_[cur].next) {
+            const Order& r = pool_[cur];
+            const bool better = (side == Side::Buy) ? r.price > d.px : r.price < d.px;
+            if (d.orders == 0 || better) d.px = r.price;
+            d.qty += r.remaining;
+            ++d.orders;
+        }
+        out[written++] = d;
+    }
+    return written;
+}
@@ -0,0 +1,171 @@
+#include "exchange/pipelined_replayer.hpp"
+#include "core/types.hpp"
+#include "exchange/replay_format.hpp"
+
+#include <span>
+#include <thread>
+
+using namespace nanomarket::core;
+namespace em = nanomarket::exchange;
+
+em::PipelinedReplayer::PipelinedReplayer(const Config& cfg, OrderBook& book, nanomarket::risk::RiskEngine& risk) noexcept
+    : cfg_(cfg), book_(book), risk_(risk) {}
+
+uint32_t em::PipelinedReplayer::take(IndexRing& ring, uint64_t& stalls, int64_t& stall_ns) noexcept {
+    uint32_t idx;
+    if (ring.pop(idx)) return idx;
+    // Count one stall per wait episode; spin politely until the neighbour stage catches up.
+    ++stalls;
+    const Timestamp t0 = now_ns();
+    while (!ring.pop(idx)) std::this_thread::yield();
+    stall_ns += now_ns() - t0;
+    return idx;
+}
+
+void em::PipelinedReplayer::decode_stage(FILE* in) noexcept {
+    StageStats& st = stats_.decode;
+    ReplayDecoder decoder;
+    char line[512];
+    bool eof = false;
+    while (!eof) {
+        const uint32_t slot = take(decoded_free_, st.output_stalls, st.output_stall_ns);
+        const Timestamp t0 = now_ns();
+        DecodedBatch& b = decoded_[slot];
+        b.count = 0;
+        while (b.count < kBatchEvents) {
+            if (!std::fgets(line, sizeof(line), in)) { eof = true; break; }
+            if (decoder.parse_line(line, b.orders[b.count])) ++b.count;
+        }
+        b.last = eof;
+        st.events += b.count;
+        ++st.batches;
+        st.busy_ns += now_ns() - t0;
+        decoded_full_.push(slot); // never full: the ring holds more indices than there are slots
+    }
+}
+
+void em::PipelinedReplayer::match_stage() noexcept {
+    StageStats& st = stats_.match;
+    uint32_t rslot = take(results_free_, st.output_stalls, st.output_stall_ns);
+    ResultBatch* r = &results_[rslot];
+    r->count = 0;
+    r->exec_count = 0;
+    r->last = false;
+
+    while (true) {
+        const uint32_t dslot = take(decoded_full_, st.input_stalls, st.input_stall_ns);
+        const Timestamp t0 = now_ns();
+        const int64_t stalled_before = st.output_stall_ns;
+        const DecodedBatch& d = decoded_[dslot];
+
+        // Risk terms for the whole batch in one pass; position and notional limits are still
+        // checked per order against the state left by the orders before it.
+        const std::span<const Order> orders(d.orders, d.count);
+        risk_.prepare_batch(orders, terms_);
+        book_.submit_batch<kMaxExecsPerEvent>(
+            orders, [&](size_t i, const Order&) { return risk_.check_prepared(terms_, i); },
+            [&](size_t, const Order& o, bool accepted, const Execution* execs, size_t n) {
+                if (r->count == kBatchEvents || kBatchExecs - r->exec_count < kMaxExecsPerEvent) {
+                    results_full_.push(rslot);
+                    ++st.batches;
+                    rslot = take(results_free_, st.output_stalls, st.output_stall_ns);
+                    r = &results_[rslot];
+                    r->count = 0;
+                    r->exec_count = 0;
+                    r->last = false;
+                }
+
+                EventRecord& ev = r->events[r->count++];
+                ev.order = o;
+                ev.exec_begin = r->exec_count;
+                ev.exec_count = 0;
+                ev.rejected = !accepted;
+                if (!accepted) return;
+
+                Execution* out = &r->execs[r->exec_count];
+                for (size_t k = 0; k < n; ++k) {
+                    out[k] = execs[k];
+                    risk_.on_fill(execs[k].price, execs[k].filled_qty, o.side);
+                }
+                ev.exec_count = static_cast<uint32_t>(n);
+                r->exec_count += static_cast<uint32_t>(n);
+                ev.position = risk_.position();
+                ev.notional = risk_.notional();
+            });
+
+        const bool last = d.last;
+        st.events += d.count;
+        st.busy_ns += (now_ns() - t0) - (st.output_stall_ns - stalled_before);
+        decoded_free_.push(dslot);
+        if (last) {
+            r->last = true;
+            results_full_.push(rslot);
+            ++st.batches;
+            return;
+        }
+    }
+}
+
+void em::PipelinedReplayer::output_stage(FILE* out) noexcept {
+    StageStats& st = stats_.output;
+    ReplayDigest* digest = cfg_.digest;
+    while (true) {
+        const uint32_t slot = take(results_full_, st.input_stalls, st.input_stall_ns);
+        const Timestamp t0 = now_ns();
+        const ResultBatch& r = results_[slot];
+        for (uint32_t i = 0; i < r.count; ++i) {
+            const EventRecord& ev = r.events[i];
+            if (ev.rejected) {
+                if (out) write_reject(out, ev.order);
+                if (digest) { digest->on_reject(ev.order); digest->end_event(); }
+                continue;
+            }
+            for (uint32_t k = 0; k < ev.exec_count; ++k) {
+                const Execution& e = r.execs[ev.exec_begin + k];
+                if (digest) digest->on_execution(e);
+                if (out) write_execution(out, e);
+            }
+            if (out) write_risk(out, ev.order.ts, ev.position, ev.notional);
+            if (digest) { digest->on_risk(ev.order.ts, ev.position, ev.notional); digest->end_event(); }
+        }
+        const bool last = r.last;
+        st.events += r.count;
+        ++st.batches;
+        st.busy_ns += now_ns() - t0;
+        results_free_.push(slot);
+        if (last) break;
+    }
+    if (digest) digest->finish();
+    if (out) std::fflush(out);
+}
+
+int em::PipelinedReplayer::run() noexcept {
+    if (!cfg_.infile) return -1;
+    FILE* in = nullptr;
+    if (fopen_s(&in, cfg_.infile, "r") != 0 || !in) return -1;
+    FILE* out = nullptr;
+    if (cfg_.outfile && (fopen_s(&out, cfg_.outfile, "w") != 0 || !out)) { std::fclose(in); return -1; }
+
+    // All batch memory is allocated here, before any stage starts.
+    decoded_.assign(kSlots, DecodedBatch{});
+    results_.resize(kSlots);
+    for (uint32_t i = 0; i < kSlots; ++i) { decoded_free_.push(i); results_free_.push(i); }
+    stats_ = Stats{};
+
+    const Timestamp t0 = now_ns();
+    std::thread decoder(&PipelinedReplayer::decode_stage, this, in);
+    std::thread writer(&PipelinedReplayer::output_stage, this, out);
+    match_stage();
+    decoder.join();
+    writer.join();
+    stats_.wall_ns = now_ns() - t0;
+
+    // Leave the rings empty so run() can be called again.
+    uint32_t idx;
+    while (decoded_free_.pop(idx)) {}
+    while (results_free_.pop(idx)) {}
+
+    std::fclose(in);
+    if (out) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "exchange/replay_decoder.hpp"
+#include "core/types.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+using namespace nanomarket::core;
+namespace em = nanomarket::exchange;
+
+bool em::ReplayDecoder::parse_line(char* buf, Order& out) noexcept {
+    // CSV format: ORDER,id,side(B|S),price,qty[,ts]
+    // Example: ORDER,1,B,10002,5,10
+    // We operate in-place over the buffer to avoid allocations.
+    char* ctx = nullptr;
+    char* tok = strtok_s(buf, ",\n\r", &ctx);
+    if (!tok) return false;
+    if (std::strcmp(tok, "ORDER") != 0) return false;
+
+    // id
+    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
+    out.id = static_cast<OrderId>(std::strtoull(tok, nullptr, 10));
+
+    // side
+    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
+    out.side = (tok[0] == 'B') ? Side::Buy : Side::Sell;
+
+    // price
+    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
+    out.price = static_cast<Price>(std::strtoll(tok, nullptr, 10));
+
+    // qty
+    tok = strtok_s(nullptr, ",\n\r", &ctx); if (!tok) return false;
+    out.qty = static_cast<Qty>(std::strtol(tok, nullptr, 10));
+    out.remaining = out.qty;
+
+    // optional ts
+    tok = strtok_s(nullptr, ",\n\r", &ctx);
+    if (tok) {
+        out.ts = static_cast<Timestamp>(std::strtoll(tok, nullptr, 10));
+        logical_ts_ = out.ts + 1;
+    } else {
+        out.ts = logical_ts_++;
+    }
+
+    out.next = -1;
+    return true;
+}
+
+bool em::ReplayDecoder::decode_file(const char* path, std::vector<Order>& out) {
+    FILE* f = nullptr;
+    if (!path || fopen_s(&f, path, "r") != 0 || !f) return false;
+    ReplayDecoder dec;
+    char line[512];
+    Order o;
+    while (std::fgets(line, sizeof(line), f)) {
+        if (dec.parse_line(line, o)) out.push_back(o);
+    }
+    std::fclose(f);
+    return true;
+}
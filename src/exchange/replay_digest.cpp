@@ -0,0 +1,124 @@
+#include "exchange/replay_digest.hpp"
+#include "core/types.hpp"
+
+#include <cstdio>
+
+using namespace nanomarket::core;
+namespace em = nanomarket::exchange;
+
+namespace {
+
+constexpr uint64_t kSeed = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t kMul1 = 0xBF58476D1CE4E5B9ULL;
+constexpr uint64_t kMul2 = 0x94D049BB133111EBULL;
+constexpr uint32_t kFileMagic = 0x47444D4E; // "NMDG"
+constexpr uint32_t kFileVersion = 1;
+
+// Record tags keep e.g. a reject and a risk snapshot with equal fields from hashing alike.
+enum : uint64_t { kTagReject = 1, kTagExec = 2, kTagRisk = 3 };
+
+inline uint64_t rotl(uint64_t x, int r) noexcept { return (x << r) | (x >> (64 - r)); }
+
+// splitmix64 finaliser: full avalanche, a few cycles per word
+inline uint64_t finalize(uint64_t z) noexcept {
+    z = (z ^ (z >> 30)) * kMul1;
+    z = (z ^ (z >> 27)) * kMul2;
+    return z ^ (z >> 31);
+}
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t interval;
+    uint64_t count;
+};
+
+} // namespace
+
+em::ReplayDigest::ReplayDigest(uint64_t interval) noexcept
+    : interval_(interval ? interval : 1), segment_(kSeed) {}
+
+void em::ReplayDigest::mix(uint64_t v) noexcept {
+    segment_ = rotl(segment_ ^ (v * kMul1), 29) * kMul2;
+}
+
+void em::ReplayDigest::on_reject(const Order& o) noexcept {
+    mix(kTagReject);
+    mix(static_cast<uint64_t>(o.ts));
+    mix(o.id);
+    mix(static_cast<uint64_t>(static_cast<int64_t>(o.side)));
+}
+
+void em::ReplayDigest::on_execution(const Execution& e) noexcept {
+    mix(kTagExec);
+    mix(static_cast<uint64_t>(e.ts));
+    mix(e.resting_id);
+    mix(e.incoming_id);
+    mix(static_cast<uint64_t>(static_cast<int64_t>(e.filled_qty)));
+    mix(static_cast<uint64_t>(e.price));
+}
+
+void em::ReplayDigest::on_risk(core::Timestamp ts, int64_t position, int64_t notional) noexcept {
+    mix(kTagRisk);
+    mix(static_cast<uint64_t>(ts));
+    mix(static_cast<uint64_t>(position));
+    mix(static_cast<uint64_t>(notional));
+}
+
+void em::ReplayDigest::end_event() noexcept {
+    if (++events_ % interval_ == 0) finish();
+}
+
+void em::ReplayDigest::finish() noexcept {
+    if (!checkpoints_.empty() && checkpoints_.back().events == events_) return; // nothing new
+    const uint64_t seg = finalize(segment_ ^ events_);
+    chain_ = finalize(rotl(chain_, 17) ^ seg);
+    checkpoints_.push_back(Checkpoint{events_, seg, chain_});
+    segment_ = kSeed;
+}
+
+bool em::ReplayDigest::save(const char* path) const noexcept {
+    FILE* f = nullptr;
+    if (!path || fopen_s(&f, path, "wb") != 0 || !f) return false;
+    FileHeader h{kFileMagic, kFileVersion, interval_, checkpoints_.size()};
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    if (ok && !checkpoints_.empty())
+        ok = std::fwrite(checkpoints_.data(), sizeof(Checkpoint), checkpoints_.size(), f) == checkpoints_.size();
+    std::fclose(f);
+    return ok;
+}
+
+bool em::ReplayDigest::load(const char* path, uint64_t& interval, std::vector<Checkpoint>& out) {
+    FILE* f = nullptr;
+    if (!path || fopen_s(&f, path, "rb") != 0 || !f) return false;
+    FileHeader h{};
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1 && h.magic == kFileMagic && h.version == kFileVersion;
+    if (ok) {
+        out.resize(static_cast<size_t>(h.count));
+        ok = h.count == 0 || std::fread(out.data(), sizeof(Checkpoint), out.size(), f) == out.size();
+        interval = h.interval;
+    }
+    std::fclose(f);
+    return ok;
+}
+
+em::ReplayDigest::Divergence em::ReplayDigest::compare(const std::vector<Checkpoint>& a,
+                                                       const std::vector<Checkpoint>& b) noexcept {
+    Divergence d;
+    const size_t n = a.size() < b.size() ? a.size() : b.size();
+    // Chains are prefix-closed: equal up to the first divergent segment, different afterwards.
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] == b[mid]) lo = mid + 1; else hi = mid;
+    }
+    if (lo == n && a.size() == b.size()) return d;
+
+    d.diverged = true;
+    d.checkpoint = lo;
+    d.first_event = lo == 0 ? 0 : a[lo - 1].events;
+    // If one run simply stopped early, the range extends to the end of the longer run.
+    const auto& longer = a.size() >= b.size() ? a : b;
+    d.end_event = lo < n ? (a[lo].events > b[lo].events ? a[lo].events : b[lo].events) : longer.back().events;
+    return d;
+}
@@ -0,0 +1,69 @@
+#include "backtest/exchange_sim.hpp"
+#include "exchange/replay_decoder.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Usage: exchange_sim <input_csv> <participants> [order_entry_ns] [market_data_ns] [jitter_ns]
+//                     [matching_ns] [tape_scale]
+// Runs the tape through the discrete-event exchange with `participants` quoters. Participant i
+// quotes spread 1 + i % 4 with latencies scaled by 1 + (i / 4) % 4, so every spread is tried at
+// four latency tiers.
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: exchange_sim <input_csv> <participants> [order_entry_ns] [market_data_ns] [jitter_ns]"
+                     " [matching_ns] [tape_scale]\n";
+        return 1;
+    }
+
+    std::vector<nanomarket::exchange::Order> tape;
+    if (!nanomarket::exchange::ReplayDecoder::decode_file(argv[1], tape)) {
+        std::cerr << "Cannot read " << argv[1] << "\n";
+        return 1;
+    }
+
+    const int count = std::atoi(argv[2]);
+    const long long entry_ns = argc >= 4 ? std::atoll(argv[3]) : 5000;
+    const long long md_ns = argc >= 5 ? std::atoll(argv[4]) : 5000;
+    const long long jitter_ns = argc >= 6 ? std::atoll(argv[5]) : 1000;
+
+    nanomarket::backtest::SimConfig cfg;
+    cfg.matching.base_ns = argc >= 7 ? std::atoll(argv[6]) : 500;
+    cfg.tape_time_scale = argc >= 8 ? std::atoll(argv[7]) : 1000;
+
+    std::vector<nanomarket::backtest::ParticipantConfig> parts(count > 0 ? count : 0);
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const long long tier = 1 + static_cast<long long>((i / 4) % 4);
+        parts[i].quoter.spread_ticks = 1 + static_cast<int32_t>(i % 4);
+        parts[i].order_entry.base_ns = entry_ns * tier;
+        parts[i].order_entry.jitter_ns = jitter_ns;
+        parts[i].market_data.base_ns = md_ns * tier;
+        parts[i].market_data.jitter_ns = jitter_ns;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto r = nanomarket::backtest::run_exchange_sim(tape, parts, cfg);
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::printf("%6s %6s %10s %8s %10s %10s %12s %8s\n", "id", "spread", "entry_ns", "fills", "volume", "position",
+                "pnl", "rejected");
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const auto& s = r.participants[i];
+        std::printf("%6zu %6d %10lld %8lld %10lld %10lld %12lld %8lld\n", i, parts[i].quoter.spread_ticks,
+                    (long long)parts[i].order_entry.base_ns, (long long)s.fills, (long long)s.volume,
+                    (long long)s.position, (long long)s.pnl, (long long)s.rejected);
+    }
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    std::fprintf(stderr,
+                 "%llu events (%llu tape, %llu participant orders, %llu executions, %llu rejects) in %.3f s;"
+                 " simulated %.3f ms, peak in flight %zu, max engine queue %lld ns, dropped %llu\n",
+                 (unsigned long long)r.stats.events, (unsigned long long)r.stats.tape_orders,
+                 (unsigned long long)r.stats.participant_orders, (unsigned long long)r.stats.executions,
+                 (unsigned long long)r.stats.rejects, secs, r.stats.end_ns / 1e6, r.stats.peak_in_flight,
+                 (long long)r.stats.max_queue_ns, (unsigned long long)r.stats.dropped);
+    return r.stats.dropped == 0 ? 0 : 2;
+}
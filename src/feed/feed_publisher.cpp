@@ -0,0 +1,215 @@
+#include "feed/feed_publisher.hpp"
+#include "core/types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+using namespace nanomarket::core;
+namespace mf = nanomarket::feed;
+
+mf::FeedPublisher::FeedPublisher(const Config& cfg) noexcept
+    : cfg_(cfg), ring_(std::make_unique<Ring>(cfg.ring_capacity)) {}
+
+mf::FeedPublisher::~FeedPublisher() { stop(); }
+
+bool mf::FeedPublisher::start() noexcept {
+    if (running_.load(std::memory_order_acquire)) return true;
+    if ((cfg_.retransmit_window & (cfg_.retransmit_window - 1)) != 0 || cfg_.retransmit_window == 0) return false;
+    if (!make_endpoint(cfg_.feed_ip, cfg_.feed_port, feed_ep_)) return false;
+    if (!live_sock_.open()) return false;
+    if (is_multicast(feed_ep_) && !live_sock_.set_multicast_options(cfg_.multicast_ttl, true)) return false;
+
+    Endpoint any{};
+    make_endpoint("0.0.0.0", cfg_.retransmit_port, any);
+    if (!rtx_sock_.open() || !rtx_sock_.bind(any)) return false;
+
+    store_.assign(cfg_.retransmit_window, Message{});
+    running_.store(true, std::memory_order_release);
+    thr_ = std::thread(&FeedPublisher::run, this);
+    return true;
+}
+
+void mf::FeedPublisher::stop() noexcept {
+    // Announce drops at the tail of the session so their sequence numbers precede EndOfSession.
+    if (thr_.joinable() && unreported_drops_ != 0) {
+        Message gap{};
+        gap.type = kSkipped;
+        gap.id = unreported_drops_;
+        while (!ring_->push(gap)) std::this_thread::yield();
+        unreported_drops_ = 0;
+    }
+    running_.store(false, std::memory_order_release);
+    if (thr_.joinable()) thr_.join();
+}
+
+void mf::FeedPublisher::push(const Message& m) noexcept {
+    // Drops are announced in stream order by a kSkipped entry ahead of the next message that
+    // fits, so the sender reserves their sequence numbers at the right place.
+    if (unreported_drops_ != 0) {
+        Message gap{};
+        gap.type = kSkipped;
+        gap.id = unreported_drops_;
+        if (ring_->push(gap)) unreported_drops_ = 0;
+    }
+    if (unreported_drops_ != 0 || !ring_->push(m)) {
+        ++unreported_drops_;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void mf::FeedPublisher::on_add(const exchange::Order& o, core::Qty resting_qty) noexcept {
+    Message m{};
+    m.type = MsgType::Add;
+    m.side = static_cast<int8_t>(o.side);
+    m.qty = resting_qty;
+    m.id = o.id;
+    m.price = o.price;
+    m.ts = o.ts;
+    push(m);
+}
+
+void mf::FeedPublisher::on_execution(const exchange::Execution& e, core::Side aggressor) noexcept {
+    Message m{};
+    m.type = MsgType::Execution;
+    m.side = static_cast<int8_t>(aggressor);
+    m.qty = e.filled_qty;
+    m.id = e.resting_id;
+    m.id2 = e.incoming_id;
+    m.price = e.price;
+    m.ts = e.ts;
+    push(m);
+}
+
+void mf::FeedPublisher::on_top_of_book(const exchange::OrderBook::TopOfBook& top, core::Timestamp ts) noexcept {
+    Message m{};
+    m.type = MsgType::TopOfBook;
+    m.qty = top.bid_qty;
+    m.qty2 = top.ask_qty;
+    m.price = top.bid_px;
+    m.price2 = top.ask_px;
+    m.ts = ts;
+    push(m);
+}
+
+mf::FeedPublisher::Stats mf::FeedPublisher::stats() const noexcept {
+    return Stats{messages_.load(std::memory_order_relaxed), packets_.load(std::memory_order_relaxed),
+                 dropped_.load(std::memory_order_relaxed), rtx_requests_.load(std::memory_order_relaxed),
+                 rtx_messages_.load(std::memory_order_relaxed)};
+}
+
+void mf::FeedPublisher::send_packet(UdpSocket& sock, const Message* msgs, uint16_t count, uint64_t seq, uint16_t flags, const Endpoint& to) noexcept {
+    alignas(8) unsigned char buf[kMaxDatagram];
+    PacketHeader h{};
+    h.magic = kPacketMagic;
+    h.version = kProtocolVersion;
+    h.flags = flags;
+    h.seq = seq;
+    h.count = count;
+    h.send_ns = now_ns();
+    const size_t body = (flags & kFlagUnavailable) ? 0 : count * sizeof(Message);
+    std::memcpy(buf, &h, sizeof(h));
+    if (body) std::memcpy(buf + sizeof(h), msgs, body);
+    sock.send_to(buf, sizeof(h) + body, to);
+}
+
+void mf::FeedPublisher::send_live(const Message* msgs, uint16_t count) noexcept {
+    const uint64_t seq = next_seq_;
+    const uint64_t mask = store_.size() - 1;
+    for (uint16_t i = 0; i < count; ++i) store_[(seq + i) & mask] = msgs[i];
+    next_seq_ += count;
+    messages_.fetch_add(count, std::memory_order_relaxed);
+
+    ++live_packets_;
+    const bool eos = msgs[count - 1].type == MsgType::EndOfSession;
+    if (!eos && cfg_.drop_every != 0 && live_packets_ % cfg_.drop_every == 0) return; // injected loss
+    send_packet(live_sock_, msgs, count, seq, 0, feed_ep_);
+    packets_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void mf::FeedPublisher::skip_seqs(uint64_t count) noexcept {
+    const uint64_t mask = store_.size() - 1;
+    const uint64_t marked = std::min<uint64_t>(count, store_.size());
+    for (uint64_t i = 0; i < marked; ++i) store_[(next_seq_ + count - marked + i) & mask].type = kSkipped;
+    next_seq_ += count;
+}
+
+void mf::FeedPublisher::serve_retransmits() noexcept {
+    RetransmitRequest req;
+    Endpoint from;
+    while (rtx_sock_.recv_from(&req, sizeof(req), &from) == static_cast<int>(sizeof(req))) {
+        if (req.magic != kRequestMagic || req.count == 0) continue;
+        rtx_requests_.fetch_add(1, std::memory_order_relaxed);
+
+        // Serve what is still in the window. Sequence numbers that have left it, or that stand
+        // for messages dropped before sequencing, are answered with explicit unavailable replies
+        // so the subscriber can skip them as lost.
+        const uint64_t window = store_.size();
+        const uint64_t oldest = next_seq_ > window ? next_seq_ - window : 1;
+        const uint64_t end = std::min(req.seq + req.count, next_seq_);
+        const uint64_t mask = window - 1;
+        auto available = [&](uint64_t s) { return s >= oldest && store_[s & mask].type != kSkipped; };
+
+        Message batch[kMaxMsgsPerPacket];
+        for (uint64_t s = req.seq; s < end;) {
+            uint16_t n = 0;
+            const uint64_t first = s;
+            if (!available(s)) {
+                while (s < end && n < UINT16_MAX && !available(s)) { ++s; ++n; }
+                send_packet(rtx_sock_, nullptr, n, first, kFlagRetransmit | kFlagUnavailable, from);
+                continue;
+            }
+            while (s < end && n < kMaxMsgsPerPacket && available(s)) batch[n++] = store_[s++ & mask];
+            send_packet(rtx_sock_, batch, n, first, kFlagRetransmit, from);
+            rtx_messages_.fetch_add(n, std::memory_order_relaxed);
+        }
+    }
+}
+
+void mf::FeedPublisher::run() noexcept {
+    Message batch[kMaxMsgsPerPacket];
+    uint16_t n = 0;
+
+    // Natural batching: drain whatever the matching thread produced, send as soon as the ring is
+    // empty or the datagram is full. Under load packets fill up; when idle latency stays minimal.
+    while (true) {
+        const bool stopping = !running_.load(std::memory_order_acquire);
+        Message m;
+        bool got = false;
+        while (n < kMaxMsgsPerPacket && ring_->pop(m)) {
+            got = true;
+            if (m.type == kSkipped) {
+                if (n > 0) { send_live(batch, n); n = 0; }
+                skip_seqs(m.id);
+                continue;
+            }
+            batch[n++] = m;
+        }
+        if (n > 0 && (n == kMaxMsgsPerPacket || ring_->empty())) { send_live(batch, n); n = 0; }
+
+        serve_retransmits();
+        if (stopping && n == 0 && ring_->empty()) break;
+        if (!got) std::this_thread::yield();
+    }
+
+    Message eos{};
+    eos.type = MsgType::EndOfSession;
+    eos.id = next_seq_ - 1; // sequence numbers used before EndOfSession
+    const uint64_t eos_seq = next_seq_;
+    send_live(&eos, 1);
+
+    // Linger so late subscribers can close trailing gaps. EndOfSession is repeated periodically in
+    // case the datagram carrying it was lost.
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + std::chrono::milliseconds(cfg_.linger_ms);
+    auto next_eos = clock::now() + std::chrono::milliseconds(20);
+    while (clock::now() < deadline) {
+        serve_retransmits();
+        if (clock::now() >= next_eos) {
+            send_packet(live_sock_, &eos, 1, eos_seq, 0, feed_ep_);
+            next_eos += std::chrono::milliseconds(20);
+        }
+        rtx_sock_.wait_readable(1000);
+    }
+}
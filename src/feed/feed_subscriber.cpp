@@ -0,0 +1,152 @@
+#include "feed/feed_subscriber.hpp"
+#include "core/types.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace nanomarket::core;
+namespace mf = nanomarket::feed;
+
+mf::FeedSubscriber::FeedSubscriber(const Config& cfg) noexcept : cfg_(cfg) {}
+
+bool mf::FeedSubscriber::open() noexcept {
+    Endpoint feed{};
+    if (!make_endpoint(cfg_.feed_ip, cfg_.feed_port, feed)) return false;
+    if (!make_endpoint(cfg_.publisher_ip, cfg_.retransmit_port, rtx_ep_)) return false;
+    if (!sock_.open()) return false;
+    if (is_multicast(feed)) {
+        Endpoint any{};
+        make_endpoint("0.0.0.0", cfg_.feed_port, any);
+        return sock_.bind(any) && sock_.join_group(feed);
+    }
+    return sock_.bind(feed);
+}
+
+bool mf::FeedSubscriber::poll(int64_t timeout_us) noexcept {
+    alignas(8) unsigned char buf[kMaxDatagram];
+    if (sock_.wait_readable(timeout_us)) {
+        int len;
+        while ((len = sock_.recv_from(buf, sizeof(buf), nullptr)) > 0) handle_packet(buf, len);
+    }
+    // Re-request an open gap whose fill has not arrived in time (the request or reply was lost).
+    if (!pending_.empty() && now_ns() - last_request_ns_ > cfg_.retransmit_timeout_ns) {
+        request(expected_, pending_.begin()->first - expected_);
+    }
+    return !finished_;
+}
+
+void mf::FeedSubscriber::handle_packet(const unsigned char* buf, int len) noexcept {
+    if (len < static_cast<int>(sizeof(PacketHeader))) return;
+    PacketHeader h;
+    std::memcpy(&h, buf, sizeof(h));
+    if (h.magic != kPacketMagic || h.version != kProtocolVersion) return;
+    const bool retransmit = (h.flags & kFlagRetransmit) != 0;
+    const bool unavailable = retransmit && (h.flags & kFlagUnavailable) != 0;
+    if (static_cast<size_t>(len) < sizeof(h) + (unavailable ? 0 : h.count * sizeof(Message))) return;
+    ++stats_.packets;
+
+    if (!retransmit) latencies_.push_back(now_ns() - h.send_ns);
+    if (unavailable) { skip_lost(h.seq, h.seq + h.count); return; }
+
+    for (uint16_t i = 0; i < h.count; ++i) {
+        Message m;
+        std::memcpy(&m, buf + sizeof(h) + i * sizeof(Message), sizeof(m));
+        accept(h.seq + i, m);
+    }
+    drain_pending();
+}
+
+void mf::FeedSubscriber::accept(uint64_t seq, const Message& m) noexcept {
+    if (seq < expected_ || pending_.count(seq)) { ++stats_.duplicates; return; }
+    if (seq == expected_) {
+        apply(m);
+        if (on_message) on_message(seq, m);
+        ++expected_;
+        highest_seen_ = std::max(highest_seen_, seq);
+        return;
+    }
+    // seq > expected_: out of order. Request each hole once when it opens past everything seen so
+    // far; poll() retries the hole at the head of the queue if its fill does not arrive.
+    const uint64_t from = std::max(expected_, highest_seen_ + 1);
+    if (seq > from) {
+        ++stats_.gaps;
+        request(from, seq - from);
+    }
+    highest_seen_ = std::max(highest_seen_, seq);
+    pending_.emplace(seq, m);
+}
+
+void mf::FeedSubscriber::drain_pending() noexcept {
+    while (!pending_.empty() && pending_.begin()->first == expected_) {
+        apply(pending_.begin()->second);
+        if (on_message) on_message(expected_, pending_.begin()->second);
+        pending_.erase(pending_.begin());
+        ++expected_;
+    }
+}
+
+void mf::FeedSubscriber::skip_lost(uint64_t from, uint64_t end) noexcept {
+    // The publisher can no longer supply [from, end). Only act if that covers the next expected
+    // message; a stale reply for a range already closed changes nothing. Messages held in
+    // pending_ inside the range are still valid and are applied in order around the holes.
+    if (from > expected_ || end <= expected_) return;
+    for (auto it = pending_.begin(); it != pending_.end() && it->first < end; it = pending_.erase(it)) {
+        stats_.lost += it->first - expected_;
+        expected_ = it->first;
+        apply(it->second);
+        if (on_message) on_message(expected_, it->second);
+        ++expected_;
+    }
+    stats_.lost += end - expected_;
+    expected_ = end;
+    drain_pending();
+}
+
+void mf::FeedSubscriber::request(uint64_t seq, uint64_t count) noexcept {
+    RetransmitRequest req{kRequestMagic, static_cast<uint32_t>(count), seq};
+    sock_.send_to(&req, sizeof(req), rtx_ep_);
+    last_request_ns_ = now_ns();
+    ++stats_.requests;
+}
+
+void mf::FeedSubscriber::apply(const Message& m) noexcept {
+    ++stats_.applied;
+    switch (m.type) {
+    case MsgType::Add: {
+        orders_[m.id] = Resting{static_cast<Side>(m.side), m.price, m.qty};
+        auto& lvl = (static_cast<Side>(m.side) == Side::Buy) ? bids_ : asks_;
+        lvl[m.price] += m.qty;
+        break;
+    }
+    case MsgType::Cancel:
+    case MsgType::Execution: {
+        auto it = orders_.find(m.id);
+        if (it == orders_.end()) break;
+        Resting& r = it->second;
+        const Qty removed = (m.type == MsgType::Cancel) ? r.qty : std::min(m.qty, r.qty);
+        auto& lvl = (r.side == Side::Buy) ? bids_ : asks_;
+        auto li = lvl.find(r.price);
+        if (li != lvl.end()) {
+            li->second -= removed;
+            if (li->second <= 0) lvl.erase(li);
+        }
+        r.qty -= removed;
+        if (r.qty <= 0) orders_.erase(it);
+        break;
+    }
+    case MsgType::TopOfBook:
+        published_top_ = exchange::OrderBook::TopOfBook{m.price, m.qty, m.price2, m.qty2};
+        if (!(published_top_ == top_of_book())) ++stats_.top_mismatches;
+        break;
+    case MsgType::EndOfSession:
+        finished_ = true;
+        break;
+    }
+}
+
+nanomarket::exchange::OrderBook::TopOfBook mf::FeedSubscriber::top_of_book() const noexcept {
+    exchange::OrderBook::TopOfBook top;
+    if (!bids_.empty()) { top.bid_px = bids_.rbegin()->first; top.bid_qty = bids_.rbegin()->second; }
+    if (!asks_.empty()) { top.ask_px = asks_.begin()->first; top.ask_qty = asks_.begin()->second; }
+    return top;
+}
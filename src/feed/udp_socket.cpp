@@ -0,0 +1,159 @@
+#include "feed/udp_socket.hpp"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using socklen_t = int;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace nanomarket::feed {
+
+namespace {
+
+#if defined(_WIN32)
+constexpr uintptr_t kInvalid = ~uintptr_t(0);
+
+// Winsock must be initialised once per process before any socket call.
+bool ensure_winsock() noexcept {
+    static const bool ok = [] {
+        WSADATA wsa;
+        return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+    }();
+    return ok;
+}
+#endif
+
+sockaddr_in to_sockaddr(const Endpoint& ep) noexcept {
+    sockaddr_in sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = ep.addr;
+    sa.sin_port = ep.port;
+    return sa;
+}
+
+} // namespace
+
+bool make_endpoint(const char* ip, uint16_t port, Endpoint& out) noexcept {
+    in_addr a;
+    if (!ip || inet_pton(AF_INET, ip, &a) != 1) return false;
+    out.addr = a.s_addr;
+    out.port = htons(port);
+    return true;
+}
+
+bool is_multicast(const Endpoint& ep) noexcept {
+    return (ntohl(ep.addr) >> 28) == 0xE; // 224.0.0.0/4
+}
+
+UdpSocket::~UdpSocket() { close(); }
+
+bool UdpSocket::open() noexcept {
+    close();
+#if defined(_WIN32)
+    if (!ensure_winsock()) return false;
+    SOCKET s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) return false;
+    u_long nb = 1;
+    if (ioctlsocket(s, FIONBIO, &nb) != 0) { closesocket(s); return false; }
+    fd_ = static_cast<uintptr_t>(s);
+#else
+    int s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s < 0) return false;
+    int fl = fcntl(s, F_GETFL, 0);
+    if (fl < 0 || fcntl(s, F_SETFL, fl | O_NONBLOCK) < 0) { ::close(s); return false; }
+    fd_ = s;
+#endif
+    return true;
+}
+
+void UdpSocket::close() noexcept {
+#if defined(_WIN32)
+    if (fd_ != kInvalid) closesocket(static_cast<SOCKET>(fd_));
+    fd_ = kInvalid;
+#else
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+#endif
+}
+
+bool UdpSocket::is_open() const noexcept {
+#if defined(_WIN32)
+    return fd_ != kInvalid;
+#else
+    return fd_ >= 0;
+#endif
+}
+
+bool UdpSocket::bind(const Endpoint& ep) noexcept {
+    int on = 1;
+    ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+    sockaddr_in sa = to_sockaddr(ep);
+    return ::bind(fd_, reinterpret_cast<const sockaddr*>(&sa), sizeof(sa)) == 0;
+}
+
+bool UdpSocket::join_group(const Endpoint& group) noexcept {
+    ip_mreq mreq;
+    std::memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr.s_addr = group.addr;
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    return ::setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<const char*>(&mreq), sizeof(mreq)) == 0;
+}
+
+bool UdpSocket::set_multicast_options(int ttl, bool loopback) noexcept {
+#if defined(_WIN32)
+    DWORD t = static_cast<DWORD>(ttl);
+    DWORD l = loopback ? 1 : 0;
+#else
+    unsigned char t = static_cast<unsigned char>(ttl);
+    unsigned char l = loopback ? 1 : 0;
+#endif
+    return ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, reinterpret_cast<const char*>(&t), sizeof(t)) == 0 &&
+           ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, reinterpret_cast<const char*>(&l), sizeof(l)) == 0;
+}
+
+int UdpSocket::send_to(const void* data, size_t len, const Endpoint& to) noexcept {
+    sockaddr_in sa = to_sockaddr(to);
+    auto n = ::sendto(fd_, static_cast<const char*>(data), static_cast<int>(len), 0,
+                      reinterpret_cast<const sockaddr*>(&sa), sizeof(sa));
+    return n < 0 ? -1 : static_cast<int>(n);
+}
+
+int UdpSocket::recv_from(void* data, size_t len, Endpoint* from) noexcept {
+    sockaddr_in sa;
+    socklen_t sl = sizeof(sa);
+    auto n = ::recvfrom(fd_, static_cast<char*>(data), static_cast<int>(len), 0, reinterpret_cast<sockaddr*>(&sa), &sl);
+    if (n < 0) return -1;
+    if (from) { from->addr = sa.sin_addr.s_addr; from->port = sa.sin_port; }
+    return static_cast<int>(n);
+}
+
+bool UdpSocket::wait_readable(int64_t timeout_us) noexcept {
+    fd_set rd;
+    FD_ZERO(&rd);
+#if defined(_WIN32)
+    FD_SET(static_cast<SOCKET>(fd_), &rd);
+    const int nfds = 0; // ignored by Winsock
+#else
+    FD_SET(fd_, &rd);
+    const int nfds = fd_ + 1;
+#endif
+    timeval tv;
+    tv.tv_sec = static_cast<long>(timeout_us / 1000000);
+    tv.tv_usec = static_cast<long>(timeout_us % 1000000);
+    return ::select(nfds, &rd, nullptr, nullptr, &tv) > 0;
+}
+
+} // namespace nanomarket::feed
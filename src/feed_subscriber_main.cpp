@@ -0,0 +1,68 @@
+#include "feed/feed_subscriber.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Reference feed consumer: rebuilds the book from the binary feed, recovers gaps through the
+// publisher's retransmit port and reports publish-to-receive latency.
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: feed_subscriber <ip>:<port> [publisher_ip] [timeout_s]\n"
+                  << "  <ip> is the bound unicast address or the multicast group; retransmit requests\n"
+                  << "  go to publisher_ip (default 127.0.0.1) on <port>+1\n";
+        return 1;
+    }
+
+    std::string spec = argv[1];
+    auto colon = spec.rfind(':');
+    if (colon == std::string::npos) { std::cerr << "expected <ip>:<port>\n"; return 1; }
+    std::string ip = spec.substr(0, colon);
+    uint16_t port = static_cast<uint16_t>(std::atoi(spec.c_str() + colon + 1));
+    const char* publisher_ip = (argc >= 3) ? argv[2] : "127.0.0.1";
+    int timeout_s = (argc >= 4) ? std::atoi(argv[3]) : 60;
+
+    nanomarket::feed::FeedSubscriber::Config cfg;
+    cfg.feed_ip = ip.c_str();
+    cfg.feed_port = port;
+    cfg.publisher_ip = publisher_ip;
+    cfg.retransmit_port = static_cast<uint16_t>(port + 1);
+
+    nanomarket::feed::FeedSubscriber sub(cfg);
+    if (!sub.open()) {
+        std::cerr << "Cannot open feed socket on " << spec << "\n";
+        return 1;
+    }
+
+    const int64_t deadline = nanomarket::core::now_ns() + static_cast<int64_t>(timeout_s) * 1'000'000'000;
+    while (sub.poll(100'000)) {
+        if (nanomarket::core::now_ns() > deadline) {
+            std::cerr << "Timed out before EndOfSession\n";
+            break;
+        }
+    }
+
+    const auto& s = sub.stats();
+    auto top = sub.top_of_book();
+    std::cout << "packets=" << s.packets << " applied=" << s.applied << " duplicates=" << s.duplicates
+              << " gaps=" << s.gaps << " requests=" << s.requests << " lost=" << s.lost
+              << " top_mismatches=" << s.top_mismatches << "\n";
+    std::cout << "book: resting=" << sub.resting_orders() << " bid=" << top.bid_qty << "@" << top.bid_px
+              << " ask=" << top.ask_qty << "@" << top.ask_px << "\n";
+
+    std::vector<int64_t> lat = sub.latencies_ns();
+    std::sort(lat.begin(), lat.end());
+    std::cout << "latency_ns: samples=" << lat.size() << " p50=" << percentile(lat, 0.50)
+              << " p99=" << percentile(lat, 0.99) << " p99.9=" << percentile(lat, 0.999)
+              << " max=" << (lat.empty() ? 0 : lat.back()) << "\n";
+    return sub.finished() && s.lost == 0 ? 0 : 2;
+}
@@ -0,0 +1,60 @@
+#include "latency/histogram.hpp"
+
+#include <bit>
+#include <cmath>
+
+namespace nanomarket::latency {
+
+size_t Histogram::bucket_of(uint64_t v) noexcept {
+    if (v < kSub) return static_cast<size_t>(v);
+    const int msb = 63 - std::countl_zero(v);
+    const uint64_t sub = (v >> (msb - kSubBits)) & (kSub - 1);
+    return static_cast<size_t>(msb - kSubBits + 1) * kSub + static_cast<size_t>(sub);
+}
+
+int64_t Histogram::bucket_upper(size_t idx) noexcept {
+    if (idx < kSub) return static_cast<int64_t>(idx);
+    const int msb = static_cast<int>(idx / kSub) + kSubBits - 1;
+    const uint64_t sub = idx % kSub;
+    const uint64_t lower = (kSub + sub) << (msb - kSubBits);
+    return static_cast<int64_t>(lower + (uint64_t{1} << (msb - kSubBits)) - 1);
+}
+
+void Histogram::record(int64_t ns) noexcept {
+    if (ns < 0) ns = 0;
+    ++buckets_[bucket_of(static_cast<uint64_t>(ns))];
+    ++count_;
+    sum_ += ns;
+    if (ns < min_) min_ = ns;
+    if (ns > max_) max_ = ns;
+}
+
+void Histogram::merge(const Histogram& other) noexcept {
+    for (size_t i = 0; i < kBuckets; ++i) buckets_[i] += other.buckets_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    if (other.count_ && other.min_ < min_) min_ = other.min_;
+    if (other.max_ > max_) max_ = other.max_;
+}
+
+void Histogram::reset() noexcept {
+    *this = Histogram{};
+}
+
+int64_t Histogram::percentile(double p) const noexcept {
+    if (count_ == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count_)));
+    if (rank < 1) rank = 1;
+    if (rank > count_) rank = count_;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            const int64_t up = bucket_upper(i);
+            return up < max_ ? up : max_;
+        }
+    }
+    return max_;
+}
+
+} // namespace nanomarket::latency
@@ -0,0 +1,39 @@
+#include "latency/pacer.hpp"
+#include "core/types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace nanomarket::latency {
+
+void Pacer::calibrate() noexcept {
+    constexpr int kReads = 10000;
+    const int64_t t0 = core::now_ns();
+    for (int i = 0; i < kReads - 1; ++i) (void)core::now_ns();
+    clock_cost_ns_ = (core::now_ns() - t0) / kReads;
+
+    // Worst observed overshoot of a short sleep, doubled for headroom, at least 50 us.
+    int64_t worst = 0;
+    for (int i = 0; i < 20; ++i) {
+        const int64_t s = core::now_ns();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        worst = std::max<int64_t>(worst, core::now_ns() - s - 100'000);
+    }
+    sleep_slack_ns_ = std::max<int64_t>(2 * worst, 50'000);
+}
+
+int64_t Pacer::wait_until(int64_t deadline_ns) const noexcept {
+    int64_t now = core::now_ns();
+    if (deadline_ns - now > sleep_slack_ns_) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now - sleep_slack_ns_));
+        now = core::now_ns();
+    }
+    while (now < deadline_ns) {
+        NANOMARKET_CPU_RELAX();
+        now = core::now_ns();
+    }
+    return now;
+}
+
+} // namespace nanomarket::latency
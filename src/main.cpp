@@ -1,50 +1,141 @@
+#include "exchange/market_snapshot.hpp"
 #include "exchange/order_book.hpp"
 #include "latency/timer.hpp"
 #include "strategy/strategy.hpp"
 #include "risk/risk.hpp"
 #include "utils/ring_buffer.hpp"
+#include "utils/shm_ring.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <span>
 #include <thread>
 #include <vector>
 
 using namespace nanomarket::core;
 
-int main() {
+// Usage: nanomarket [--shm <segment>]
+//   default: run the MarketMaker in-process and consume its orders for a fixed number of iterations
+//   --shm  : create a shared-memory order ring and consume orders from an out-of-process strategy
+//            (nanomarket_strategy <segment>) until it detaches or dies
+int main(int argc, char** argv) {
+    const char* shm_name = nullptr;
+    if (argc >= 3 && std::strcmp(argv[1], "--shm") == 0) shm_name = argv[2];
+
     // Build components
     nanomarket::exchange::OrderBook::Config cfg{1, 64, 1024, 10000};
     nanomarket::exchange::OrderBook book(cfg);
+    nanomarket::risk::RiskEngine risk;
+
+    // Lock-free snapshots for monitoring: published by this thread after each drained batch,
+    // read by the monitor thread without ever blocking the matcher.
+    nanomarket::exchange::SnapshotPublisher snapshots;
+    std::atomic<bool> monitoring{true};
+    int64_t max_abs_position = 0;
+    uint64_t snapshots_read = 0;
+    std::thread monitor([&] {
+        while (monitoring.load(std::memory_order_acquire)) {
+            auto s = snapshots.read();
+            max_abs_position = std::max<int64_t>(max_abs_position, std::llabs(s.position));
+            ++snapshots_read;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    auto stop_monitor = [&] {
+        monitoring.store(false, std::memory_order_release);
+        monitor.join();
+        std::cout << "Monitor: snapshots read=" << snapshots_read << " published=" << snapshots.published()
+                  << " max |position|=" << max_abs_position << "\n";
+    };
+
+    // Drain everything queued in `ring` through OrderBook::submit_batch, up to BatchTerms::kMax
+    // orders per call, so the book can prefetch ahead and risk terms are computed per batch.
+    // Returns whether anything was consumed; `last_ts` keeps the last consumed order's timestamp
+    // for the snapshots published after a drain.
+    Timestamp last_ts = 0;
+    nanomarket::risk::BatchTerms terms;
+    nanomarket::exchange::Order batch[nanomarket::risk::BatchTerms::kMax];
+    auto drain = [&](auto& ring) {
+        bool any = false;
+        while (true) {
+            size_t n = 0;
+            while (n < std::size(batch) && ring.pop(batch[n])) ++n;
+            if (n == 0) return any;
+            any = true;
+            last_ts = batch[n - 1].ts;
+
+            // latency measurement: tick-to-submit, one sample per batch handed to the book
+            nanomarket::latency::ScopedTimer t("tick_to_submit");
+            const std::span<const nanomarket::exchange::Order> orders(batch, n);
+            risk.prepare_batch(orders, terms);
+            book.submit_batch<128>(
+                orders, [&](size_t i, const nanomarket::exchange::Order&) { return risk.check_prepared(terms, i); },
+                [&](size_t, const nanomarket::exchange::Order& o, bool accepted,
+                    const nanomarket::exchange::Execution* out, size_t m) {
+                    if (!accepted) {
+                        std::cout << "Order rejected by risk id=" << o.id << "\n";
+                        return;
+                    }
+                    for (size_t i = 0; i < m; ++i) {
+                        auto &e = out[i];
+                        risk.on_fill(e.price, e.filled_qty, (o.side == Side::Buy) ? Side::Buy : Side::Sell);
+                        snapshots.on_execution(e);
+                        std::cout << "Exec: resting=" << e.resting_id << " incoming=" << e.incoming_id << " qty=" << e.filled_qty << "@" << e.price << "\n";
+                    }
+                });
+        }
+    };
+
+    if (shm_name) {
+        using ShmRing = nanomarket::utils::ShmSpscRing<nanomarket::exchange::Order, 1024>;
+        auto ring = std::make_unique<ShmRing>();
+        if (!ring->create(shm_name, ShmRing::Role::Consumer)) {
+            std::cerr << "Cannot create shared-memory ring " << shm_name << "\n";
+            stop_monitor();
+            return 1;
+        }
+        std::cout << "Waiting for strategy on " << shm_name << "\n";
+
+        // Consume until a strategy has attached and then gone away (detached or process died).
+        const int64_t heartbeat_timeout_ns = 1'000'000'000;
+        bool seen = false;
+        while (true) {
+            if (drain(*ring)) snapshots.publish(book, risk, last_ts);
+            ring->heartbeat();
+            const bool alive = ring->peer_alive(heartbeat_timeout_ns);
+            if (alive && !seen) std::cout << "Strategy attached\n";
+            if (!alive && seen) {
+                drain(*ring);
+                std::cout << (ring->peer_attached() ? "Strategy unresponsive or dead\n" : "Strategy detached\n");
+                snapshots.publish(book, risk, last_ts);
+                break;
+            }
+            seen = seen || alive;
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        stop_monitor();
+        std::cout << "Run complete." << std::endl;
+        return 0;
+    }
 
     nanomarket::utils::SpscRing<nanomarket::exchange::Order, 1024> ring;
     nanomarket::strategy::MarketMaker mm(&ring);
-    nanomarket::risk::RiskEngine risk;
 
     mm.start();
 
     // main loop: consume orders from strategy and pass to exchange through risk
     for (int iter = 0; iter < 1000; ++iter) {
-        nanomarket::exchange::Order o;
-        while (ring.pop(o)) {
-            // latency measurement: measure tick-to-trade start
-            {
-                nanomarket::latency::ScopedTimer t("tick_to_submit");
-                if (!risk.check_new_order(o.price, o.qty, o.side)) {
-                    std::cout << "Order rejected by risk id=" << o.id << "\n";
-                    continue;
-                }
-                nanomarket::exchange::Execution out[128];
-                size_t n = book.submit_order(o, out, 128);
-                for (size_t i = 0; i < n; ++i) {
-                    auto &e = out[i];
-                    risk.on_fill(e.price, e.filled_qty, (o.side == Side::Buy) ? Side::Buy : Side::Sell);
-                    std::cout << "Exec: resting=" << e.resting_id << " incoming=" << e.incoming_id << " qty=" << e.filled_qty << "@" << e.price << "\n";
-                }
-            }
-        }
+        if (drain(ring)) snapshots.publish(book, risk, last_ts);
         std::this_thread::sleep_for(std::chrono::microseconds(500));
     }
 
     mm.stop();
+    stop_monitor();
     std::cout << "Run complete." << std::endl;
     return 0;
 }
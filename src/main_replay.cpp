@@ -1,17 +1,105 @@
 #include "exchange/market_replayer.hpp"
 #include "exchange/order_book.hpp"
+#include "exchange/pipelined_replayer.hpp"
+#include "feed/feed_publisher.hpp"
 #include "risk/risk.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
+
+static void usage() {
+    std::cerr << "Usage: main_replay <input_csv> [output_log] [--feed <ip>:<port>] [--digest <file>]\n"
+              << "                   [--digest-every <events>] [--no-log] [--pipelined] [--speed <x>]\n"
+              << "                   [--ts-scale <ns>]\n"
+              << "  --feed          publish binary market data to <ip>:<port> (unicast or multicast);\n"
+              << "                  retransmit requests are served on <port>+1\n"
+              << "  --digest        write a checkpointed digest of the output (compare with digest_compare)\n"
+              << "  --digest-every  events per digest checkpoint (default 1048576)\n"
+              << "  --no-log        skip the text log\n"
+              << "  --pipelined     decode, match and output on separate threads (same output);\n"
+              << "                  prints per-stage occupancy and stall counters\n"
+              << "  --speed         paced open-loop replay at <x> times the tape's ts rate; prints\n"
+              << "                  latency percentiles from scheduled release and per-second throughput\n"
+              << "  --ts-scale      nanoseconds per unit of the tape's ts column for --speed\n"
+              << "                  (default 1000: ts in microseconds, as exchange_sim)\n";
+}
+
+static void print_pipeline_stats(const nanomarket::exchange::PipelinedReplayer::Stats& s) {
+    auto row = [&](const char* name, const nanomarket::exchange::PipelinedReplayer::StageStats& st) {
+        const double wall = s.wall_ns > 0 ? static_cast<double>(s.wall_ns) : 1.0;
+        std::fprintf(stderr, "%-7s events=%llu batches=%llu occupancy=%5.1f%% input_stalls=%llu (%.1f%%) output_stalls=%llu (%.1f%%)\n",
+                     name, (unsigned long long)st.events, (unsigned long long)st.batches, 100.0 * st.busy_ns / wall,
+                     (unsigned long long)st.input_stalls, 100.0 * st.input_stall_ns / wall,
+                     (unsigned long long)st.output_stalls, 100.0 * st.output_stall_ns / wall);
+    };
+    std::fprintf(stderr, "pipeline wall=%.3f ms\n", s.wall_ns / 1e6);
+    row("decode", s.decode);
+    row("match", s.match);
+    row("output", s.output);
+}
+
+static void print_paced_stats(const nanomarket::exchange::MarketDataReplayer::PacedStats& s) {
+    auto row = [](const char* name, const nanomarket::latency::Histogram& h) {
+        std::fprintf(stderr, "%-8s p50=%lld p90=%lld p99=%lld p99.9=%lld p99.99=%lld max=%lld mean=%.0f (ns)\n", name,
+                     (long long)h.percentile(50), (long long)h.percentile(90), (long long)h.percentile(99),
+                     (long long)h.percentile(99.9), (long long)h.percentile(99.99), (long long)h.max(), h.mean());
+    };
+    std::fprintf(stderr, "paced: %llu events in %.3f s, max start lag %lld ns\n",
+                 (unsigned long long)s.latency.count(), s.wall_ns / 1e9, (long long)s.max_lag_ns);
+    row("latency", s.latency);
+    row("service", s.service);
+    for (size_t i = 0; i < s.per_second.size(); ++i)
+        std::fprintf(stderr, "second %zu: %llu events\n", i, (unsigned long long)s.per_second[i]);
+}
 
 int main(int argc, char** argv) {
     if (argc < 2) {
-        std::cerr << "Usage: main_replay <input_csv> [output_log]\n";
+        usage();
         return 1;
     }
 
     const char* infile = argv[1];
-    const char* outfile = (argc >= 3) ? argv[2] : "replay.log";
+    const char* outfile = "replay.log";
+    std::string feed_ip;
+    uint16_t feed_port = 0;
+    const char* digest_file = nullptr;
+    uint64_t digest_every = 1u << 20;
+    bool no_log = false;
+    bool pipelined = false;
+    double speed = 0.0;
+    int64_t ts_scale = 1000;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--feed") == 0 && i + 1 < argc) {
+            std::string spec = argv[++i];
+            auto colon = spec.rfind(':');
+            if (colon == std::string::npos) { usage(); return 1; }
+            feed_ip = spec.substr(0, colon);
+            feed_port = static_cast<uint16_t>(std::atoi(spec.c_str() + colon + 1));
+        } else if (std::strcmp(argv[i], "--digest") == 0 && i + 1 < argc) {
+            digest_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--digest-every") == 0 && i + 1 < argc) {
+            digest_every = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--no-log") == 0) {
+            no_log = true;
+        } else if (std::strcmp(argv[i], "--pipelined") == 0) {
+            pipelined = true;
+        } else if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            speed = std::atof(argv[++i]);
+            if (speed <= 0.0) { usage(); return 1; }
+        } else if (std::strcmp(argv[i], "--ts-scale") == 0 && i + 1 < argc) {
+            ts_scale = std::atoll(argv[++i]);
+            if (ts_scale <= 0) { usage(); return 1; }
+        } else if (argv[i][0] != '-') {
+            outfile = argv[i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
 
     nanomarket::exchange::OrderBook::Config cfg{1, 64, 1024, 10000};
     nanomarket::exchange::OrderBook book(cfg);
@@ -19,14 +107,67 @@ int main(int argc, char** argv) {
 
     nanomarket::exchange::MarketDataReplayer::Config rcfg;
     rcfg.infile = infile;
-    rcfg.outfile = outfile;
+    rcfg.outfile = no_log ? nullptr : outfile;
+    rcfg.speed = speed;
+    rcfg.tape_time_scale = ts_scale;
 
-    nanomarket::exchange::MarketDataReplayer replayer(rcfg, book, risk);
-    int r = replayer.run();
+    nanomarket::exchange::ReplayDigest digest(digest_every);
+    if (digest_file) rcfg.digest = &digest;
+
+    if (pipelined && feed_port != 0) {
+        std::cerr << "--feed is only supported by the serial replayer\n";
+        return 1;
+    }
+    if (pipelined && speed > 0.0) {
+        std::cerr << "--speed is only supported by the serial replayer\n";
+        return 1;
+    }
+
+    nanomarket::feed::FeedPublisher::Config fcfg;
+    fcfg.feed_ip = feed_ip.c_str();
+    fcfg.feed_port = feed_port;
+    fcfg.retransmit_port = static_cast<uint16_t>(feed_port + 1);
+    nanomarket::feed::FeedPublisher feed(fcfg);
+    if (feed_port != 0) {
+        if (!feed.start()) {
+            std::cerr << "Cannot start feed publisher on " << feed_ip << ":" << feed_port << "\n";
+            return 1;
+        }
+        rcfg.feed = &feed;
+    }
+
+    int r = 0;
+    if (pipelined) {
+        nanomarket::exchange::PipelinedReplayer::Config pcfg;
+        pcfg.infile = rcfg.infile;
+        pcfg.outfile = rcfg.outfile;
+        pcfg.digest = rcfg.digest;
+        nanomarket::exchange::PipelinedReplayer replayer(pcfg, book, risk);
+        r = replayer.run();
+        print_pipeline_stats(replayer.stats());
+    } else {
+        nanomarket::exchange::MarketDataReplayer replayer(rcfg, book, risk);
+        r = replayer.run();
+        if (r == 0 && speed > 0.0) print_paced_stats(replayer.paced_stats());
+    }
+    feed.stop();
     if (r != 0) {
         std::cerr << "Replay failed\n";
         return r;
     }
-    std::cout << "Replay complete. Output: " << outfile << "\n";
+    std::cout << "Replay complete. Output: " << (no_log ? "(none)" : outfile) << "\n";
+    if (digest_file) {
+        if (!digest.save(digest_file)) {
+            std::cerr << "Cannot write digest " << digest_file << "\n";
+            return 1;
+        }
+        std::cout << "Digest: " << digest.events() << " events, " << digest.checkpoints().size()
+                  << " checkpoints -> " << digest_file << "\n";
+    }
+    if (feed_port != 0) {
+        auto s = feed.stats();
+        std::cout << "Feed: messages=" << s.messages << " packets=" << s.packets << " dropped=" << s.dropped
+                  << " retransmit_requests=" << s.retransmit_requests << " retransmitted=" << s.retransmitted << "\n";
+    }
     return 0;
 }
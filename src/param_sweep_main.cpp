@@ -0,0 +1,62 @@
+#include "backtest/param_sweep.hpp"
+#include "exchange/replay_decoder.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Usage: param_sweep <input_csv> <spreads> <sizes> <max_sizes> [threads] [max_notional]
+//   lists are comma-separated, e.g. param_sweep data/sample_replay.csv 1,2,4 1,2 5,10
+// Decodes the tape once and runs every spread x size x max_size Quoter configuration over it.
+
+static std::vector<int32_t> parse_list(const char* s) {
+    std::vector<int32_t> out;
+    std::string cur;
+    for (const char* p = s;; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!cur.empty()) out.push_back(static_cast<int32_t>(std::atoi(cur.c_str())));
+            cur.clear();
+            if (*p == '\0') break;
+        } else {
+            cur.push_back(*p);
+        }
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 5) {
+        std::cerr << "Usage: param_sweep <input_csv> <spreads> <sizes> <max_sizes> [threads] [max_notional]\n";
+        return 1;
+    }
+
+    std::vector<nanomarket::exchange::Order> tape;
+    if (!nanomarket::exchange::ReplayDecoder::decode_file(argv[1], tape)) {
+        std::cerr << "Cannot read " << argv[1] << "\n";
+        return 1;
+    }
+
+    auto grid = nanomarket::backtest::make_grid(parse_list(argv[2]), parse_list(argv[3]), parse_list(argv[4]));
+    nanomarket::backtest::SweepConfig cfg;
+    if (argc >= 6) cfg.threads = static_cast<unsigned>(std::atoi(argv[5]));
+    if (argc >= 7) cfg.max_notional = std::atoll(argv[6]);
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto results = nanomarket::backtest::run_sweep(tape, grid, cfg);
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::printf("%8s %6s %8s %8s %10s %10s %8s %12s %12s %8s\n", "spread", "size", "max_size", "fills",
+                "volume", "position", "max_pos", "cash", "pnl", "rejected");
+    for (const auto& r : results) {
+        std::printf("%8d %6d %8d %8lld %10lld %10lld %8lld %12lld %12lld %8lld\n", r.settings.spread_ticks,
+                    r.settings.size, r.settings.max_size, (long long)r.summary.fills, (long long)r.summary.volume,
+                    (long long)r.summary.position, (long long)r.summary.max_abs_position, (long long)r.summary.cash,
+                    (long long)r.summary.pnl, (long long)r.summary.rejected);
+    }
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    std::fprintf(stderr, "%zu events x %zu configs in %.3f s\n", tape.size(), grid.size(), secs);
+    return 0;
+}
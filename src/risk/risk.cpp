@@ -19,6 +19,29 @@ bool r::RiskEngine::check_new_order(core::Price price, core::Qty qty, core::Side
     return true;
 }
 
+size_t r::RiskEngine::prepare_batch(std::span<const nanomarket::exchange::Order> orders, BatchTerms& t) const noexcept {
+    const size_t n = orders.size() < BatchTerms::kMax ? orders.size() : BatchTerms::kMax;
+    const int64_t max_size = limits_.max_order_size.load(std::memory_order_relaxed);
+    const nanomarket::exchange::Order* o = orders.data();
+    for (size_t i = 0; i < n; ++i) {
+        const int64_t q = o[i].qty;
+        t.delta[i] = static_cast<int64_t>(static_cast<int>(o[i].side)) * q;
+        t.notional[i] = static_cast<int64_t>(o[i].price) * q;
+        t.size_ok[i] = static_cast<uint8_t>((q < 0 ? -q : q) <= max_size);
+    }
+    t.count = n;
+    return n;
+}
+
+bool r::RiskEngine::check_prepared(const BatchTerms& t, size_t i) const noexcept {
+    if (!t.size_ok[i]) return false;
+    int64_t newpos = position_.load(std::memory_order_relaxed) + t.delta[i];
+    if (std::llabs(newpos) > limits_.max_position.load(std::memory_order_relaxed)) return false;
+    int64_t newnot = notional_.load(std::memory_order_relaxed) + t.notional[i];
+    if (std::llabs(newnot) > limits_.max_notional.load(std::memory_order_relaxed)) return false;
+    return true;
+}
+
 void r::RiskEngine::on_fill(core::Price price, core::Qty qty, core::Side side) noexcept {
     // incremental updates
     int64_t delta = static_cast<int64_t>(static_cast<int>(side) * qty);
@@ -0,0 +1,90 @@
+#include "strategy/quoter.hpp"
+#include "core/types.hpp"
+
+#include <cstdlib>
+
+using namespace nanomarket::core;
+namespace ms = nanomarket::strategy;
+namespace em = nanomarket::exchange;
+
+ms::Quoter::Settings ms::Quoter::settings_from(const Params& p) noexcept {
+    return Settings{p.spread_ticks.load(std::memory_order_relaxed), p.size.load(std::memory_order_relaxed),
+                    p.max_size.load(std::memory_order_relaxed)};
+}
+
+ms::Quoter::Quoter(const Settings& s, core::Price ref_price, core::OrderId id_base) noexcept
+    : settings_(s), id_base_(id_base), next_id_(id_base), ref_price_(ref_price), last_trade_px_(ref_price) {}
+
+int ms::Quoter::on_execution(const em::Execution& e, core::Side incoming_side) noexcept {
+    // A self-match touches both of our orders; account for each side.
+    int traded = 0;
+    const int in_side = static_cast<int>(incoming_side);
+    if (owns(e.incoming_id)) {
+        sum_.position += static_cast<int64_t>(in_side) * e.filled_qty;
+        sum_.cash -= static_cast<int64_t>(in_side) * e.price * e.filled_qty;
+        ++sum_.fills;
+        sum_.volume += e.filled_qty;
+        traded = in_side;
+    }
+    if (owns(e.resting_id)) {
+        const int rest_side = -in_side;
+        sum_.position += static_cast<int64_t>(rest_side) * e.filled_qty;
+        sum_.cash -= static_cast<int64_t>(rest_side) * e.price * e.filled_qty;
+        ++sum_.fills;
+        sum_.volume += e.filled_qty;
+        if (e.resting_id == bid_id_ && (bid_open_ -= e.filled_qty) <= 0) bid_id_ = 0;
+        if (e.resting_id == ask_id_ && (ask_open_ -= e.filled_qty) <= 0) ask_id_ = 0;
+        traded = rest_side;
+    }
+    last_trade_px_ = e.price;
+    if (std::llabs(sum_.position) > sum_.max_abs_position) sum_.max_abs_position = std::llabs(sum_.position);
+    return traded;
+}
+
+void ms::Quoter::on_submitted(const em::Order& q, core::Qty filled) noexcept {
+    ++sum_.quotes;
+    const Qty open = q.qty - filled;
+    if (open <= 0) return;
+    if (q.side == Side::Buy) { bid_id_ = q.id; bid_open_ = open; }
+    else { ask_id_ = q.id; ask_open_ = open; }
+}
+
+void ms::Quoter::on_rejected(const em::Order&) noexcept {
+    ++sum_.rejected;
+}
+
+size_t ms::Quoter::requote(const em::OrderBook::TopOfBook& top, core::Timestamp ts, em::Order* out) noexcept {
+    Price ref = last_trade_px_;
+    if (top.bid_qty > 0 && top.ask_qty > 0) ref = (top.bid_px + top.ask_px) / 2;
+    if (ref == 0) ref = ref_price_;
+
+    size_t n = 0;
+    const int64_t size = settings_.size;
+    if (bid_id_ == 0 && sum_.position + size <= settings_.max_size) {
+        em::Order& q = out[n++];
+        q = em::Order{};
+        q.id = next_id_++;
+        q.side = Side::Buy;
+        q.price = ref - settings_.spread_ticks;
+        q.qty = settings_.size;
+        q.remaining = q.qty;
+        q.ts = ts;
+    }
+    if (ask_id_ == 0 && sum_.position - size >= -settings_.max_size) {
+        em::Order& q = out[n++];
+        q = em::Order{};
+        q.id = next_id_++;
+        q.side = Side::Sell;
+        q.price = ref + settings_.spread_ticks;
+        q.qty = settings_.size;
+        q.remaining = q.qty;
+        q.ts = ts;
+    }
+    return n;
+}
+
+ms::Quoter::Summary ms::Quoter::summary() const noexcept {
+    Summary s = sum_;
+    s.pnl = s.cash + s.position * last_trade_px_;
+    return s;
+}
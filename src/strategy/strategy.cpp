@@ -10,6 +10,9 @@ namespace ms = nanomarket::strategy;
 ms::MarketMaker::MarketMaker(nanomarket::utils::SpscRing<nanomarket::exchange::Order, 1024>* out_ring)
     : out_ring_(out_ring) {}
 
+ms::MarketMaker::MarketMaker(nanomarket::utils::ShmSpscRing<nanomarket::exchange::Order, 1024>* out_ring)
+    : shm_ring_(out_ring) {}
+
 ms::MarketMaker::~MarketMaker() { stop(); }
 
 void ms::MarketMaker::start() {
@@ -22,6 +25,11 @@ void ms::MarketMaker::stop() {
     if (thr_.joinable()) thr_.join();
 }
 
+void ms::MarketMaker::push(const nanomarket::exchange::Order& o) {
+    if (shm_ring_) shm_ring_->push(o);
+    else out_ring_->push(o);
+}
+
 void ms::MarketMaker::run() {
     // Deterministic pseudo-market making loop: place symmetric quotes around ref.
     core::Price ref_price = 10000;
@@ -38,7 +46,7 @@ void ms::MarketMaker::run() {
         bid.price = ref_price - spread;
         bid.qty = static_cast<Qty>(size);
         bid.ts = ts_counter++;
-        out_ring_->push(bid);
+        push(bid);
 
         // place ask
         nanomarket::exchange::Order ask = bid;
@@ -46,7 +54,9 @@ void ms::MarketMaker::run() {
         ask.id = id_counter++;
         ask.price = ref_price + spread;
         ask.ts = ts_counter++;
-        out_ring_->push(ask);
+        push(ask);
+
+        if (shm_ring_) shm_ring_->heartbeat();
 
         // sleep a deterministic interval (simple throttle)
         std::this_thread::sleep_for(std::chrono::microseconds(100));
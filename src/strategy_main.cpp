@@ -0,0 +1,50 @@
+#include "strategy/strategy.hpp"
+#include "utils/shm_ring.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+// Out-of-process MarketMaker: attaches to the matcher's shared-memory order ring as producer.
+// Usage: nanomarket_strategy <segment> [run_seconds]
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: nanomarket_strategy <segment> [run_seconds]\n";
+        return 1;
+    }
+    const char* name = argv[1];
+    const int run_s = (argc >= 3) ? std::atoi(argv[2]) : 5;
+
+    using ShmRing = nanomarket::utils::ShmSpscRing<nanomarket::exchange::Order, 1024>;
+    auto ring = std::make_unique<ShmRing>();
+
+    // The matcher may still be starting; retry briefly.
+    bool ok = false;
+    for (int i = 0; i < 50 && !(ok = ring->attach(name, ShmRing::Role::Producer)); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (!ok) {
+        std::cerr << "Cannot attach to " << name << " (missing, layout mismatch, or producer already attached)\n";
+        return 1;
+    }
+
+    nanomarket::strategy::MarketMaker mm(ring.get());
+    mm.start();
+    // The matcher refreshes its heartbeat from its poll loop; a pid check alone would be fooled by
+    // pid reuse or a hung matcher.
+    const int64_t heartbeat_timeout_ns = 1'000'000'000;
+    for (int i = 0; i < run_s * 10; ++i) {
+        if (!ring->peer_alive(heartbeat_timeout_ns)) {
+            std::cerr << "Matcher went away\n";
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    mm.stop();
+    ring->detach();
+    std::cout << "Strategy detached.\n";
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "utils/shared_segment.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nanomarket::utils {
+
+namespace {
+
+// POSIX names need a single leading '/'; Win32 names are scoped to the session.
+void platform_name(const char* name, char* out, size_t cap) noexcept {
+#if defined(_WIN32)
+    std::snprintf(out, cap, "Local\\%s", name[0] == '/' ? name + 1 : name);
+#else
+    std::snprintf(out, cap, "/%s", name[0] == '/' ? name + 1 : name);
+#endif
+}
+
+} // namespace
+
+SharedSegment::~SharedSegment() { close(); }
+
+bool SharedSegment::create(const char* name, size_t size) noexcept {
+    close();
+    platform_name(name, name_, sizeof(name_));
+#if defined(_WIN32)
+    const uint64_t sz = size;
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                  static_cast<DWORD>(sz >> 32), static_cast<DWORD>(sz & 0xFFFFFFFFu), name_);
+    if (!h) return false;
+    if (GetLastError() == ERROR_ALREADY_EXISTS) { CloseHandle(h); return false; } // someone else's mapping
+    void* p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!p) { CloseHandle(h); return false; }
+    handle_ = h;
+#else
+    int fd = shm_open(name_, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) { ::close(fd); shm_unlink(name_); return false; }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) { shm_unlink(name_); return false; }
+#endif
+    data_ = p;
+    size_ = size;
+    owner_ = true;
+    return true;
+}
+
+bool SharedSegment::attach(const char* name, size_t min_size) noexcept {
+    close();
+    platform_name(name, name_, sizeof(name_));
+#if defined(_WIN32)
+    HANDLE h = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name_);
+    if (!h) return false;
+    void* p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!p) { CloseHandle(h); return false; }
+    MEMORY_BASIC_INFORMATION info;
+    if (VirtualQuery(p, &info, sizeof(info)) == 0 || info.RegionSize < min_size) {
+        UnmapViewOfFile(p);
+        CloseHandle(h);
+        return false;
+    }
+    handle_ = h;
+    size_ = info.RegionSize;
+#else
+    int fd = shm_open(name_, O_RDWR, 0600);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < min_size) { ::close(fd); return false; }
+    void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+    data_ = p;
+    owner_ = false;
+    return true;
+}
+
+void SharedSegment::close() noexcept {
+    if (!data_) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(handle_));
+    handle_ = nullptr;
+#else
+    munmap(data_, size_);
+    if (owner_) shm_unlink(name_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    owner_ = false;
+}
+
+bool SharedSegment::remove(const char* name) noexcept {
+    char full[128];
+    platform_name(name, full, sizeof(full));
+#if defined(_WIN32)
+    HANDLE h = OpenFileMappingA(FILE_MAP_READ, FALSE, full);
+    if (!h) return true;
+    CloseHandle(h);
+    return false;
+#else
+    return shm_unlink(full) == 0 || errno == ENOENT;
+#endif
+}
+
+uint64_t current_pid() noexcept {
+#if defined(_WIN32)
+    return static_cast<uint64_t>(GetCurrentProcessId());
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+bool process_alive(uint64_t pid) noexcept {
+    if (pid == 0) return false;
+#if defined(_WIN32)
+    HANDLE h = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!h) return false;
+    const bool alive = WaitForSingleObject(h, 0) == WAIT_TIMEOUT;
+    CloseHandle(h);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+} // namespace nanomarket::utils
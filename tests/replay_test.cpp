@@ -1,10 +1,12 @@
 #include "exchange/market_replayer.hpp"
 #include "exchange/order_book.hpp"
+#include "exchange/replay_digest.hpp"
 #include "risk/risk.hpp"
 
 #include <fstream>
 #include <string>
 #include <iostream>
+#include <vector>
 
 int main() {
     using namespace nanomarket::exchange;
@@ -14,14 +16,18 @@ int main() {
     const char* infile = "..\\data\\sample_replay.csv"; // CTest runs from build dir
     const char* outfile = "replay_test_output.log";
     const char* golden = "..\\tests\\golden_replay.log";
+    const char* golden_digest = "..\\tests\\golden_replay.digest";
 
     OrderBook::Config cfg{1, 64, 1024, 10000};
     OrderBook book(cfg);
     nanomarket::risk::RiskEngine risk;
 
+    ReplayDigest digest(2);
+
     MarketDataReplayer::Config rcfg;
     rcfg.infile = infile;
     rcfg.outfile = outfile;
+    rcfg.digest = &digest;
 
     MarketDataReplayer replayer(rcfg, book, risk);
     int r = replayer.run();
@@ -30,6 +36,16 @@ int main() {
         return 1;
     }
 
+    // Compare the streaming digest with the golden digest
+    uint64_t golden_interval = 0;
+    std::vector<ReplayDigest::Checkpoint> golden_cps;
+    if (!ReplayDigest::load(golden_digest, golden_interval, golden_cps)) { std::cerr << "Cannot open golden digest\n"; return 1; }
+    auto div = ReplayDigest::compare(golden_cps, digest.checkpoints());
+    if (golden_interval != digest.interval() || div.diverged) {
+        std::cerr << "Digest mismatch in events [" << div.first_event << ", " << div.end_event << ")\n";
+        return 1;
+    }
+
     // Compare output line-by-line with golden file
     std::ifstream outfs(outfile);
     std::ifstream gfs(golden);
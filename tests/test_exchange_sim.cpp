@@ -0,0 +1,109 @@
+#include "backtest/exchange_sim.hpp"
+#include "backtest/param_sweep.hpp"
+#include "backtest/timing_wheel.hpp"
+#include "test_util.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace nanomarket::backtest;
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+
+static bool wheel_matches_reference() {
+    // Reference: ordered by (time, scheduling sequence). Times span every wheel level.
+    TimingWheel<uint64_t> wheel(1 << 16);
+    std::map<std::pair<Timestamp, uint64_t>, uint64_t> ref;
+    nanomarket::testing::Lcg rng{7};
+    uint64_t seq = 0;
+    auto next = [&]() { return rng.next() >> 11; };
+    auto schedule = [&](Timestamp at) {
+        const Timestamp t = at < wheel.now() ? wheel.now() : at;
+        if (!wheel.schedule(at, seq)) return false;
+        ref.emplace(std::make_pair(t, seq), seq);
+        ++seq;
+        return true;
+    };
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            const uint64_t r = next();
+            const int shift = static_cast<int>(r % 6) * 8; // deltas from 0 up to ~2^48 ticks
+            const Timestamp delta = static_cast<Timestamp>((r >> 8) & ((uint64_t{1} << (shift + 8)) - 1));
+            const Timestamp base = (r & 1) ? wheel.now() : wheel.now() - 5; // some in the past
+            if (!schedule(base + delta)) return false;
+            if (i % 10 == 0 && !schedule(wheel.now())) return false; // same-tick FIFO
+        }
+        for (int i = 0; i < 60 && !ref.empty(); ++i) {
+            Timestamp at = 0;
+            uint64_t v = 0;
+            if (!wheel.pop(at, v)) return false;
+            auto it = ref.begin();
+            if (it->first.first != at || it->second != v || wheel.now() != at) return false;
+            ref.erase(it);
+        }
+    }
+    Timestamp at = 0;
+    uint64_t v = 0;
+    while (wheel.pop(at, v)) {
+        auto it = ref.begin();
+        if (it == ref.end() || it->first.first != at || it->second != v) return false;
+        ref.erase(it);
+    }
+    return ref.empty() && wheel.empty();
+}
+
+int main() {
+    if (!wheel_matches_reference()) { std::cerr << "timing wheel order differs from reference\n"; return 1; }
+
+    TimingWheel<int> small(2);
+    if (!small.schedule(5, 1) || !small.schedule(5, 2) || small.schedule(5, 3)) {
+        std::cerr << "timing wheel pool limit not enforced\n";
+        return 1;
+    }
+
+    nanomarket::testing::TapeSpec spec;
+    spec.count = 5000;
+    const std::vector<Order> tape = nanomarket::testing::make_tape(spec);
+
+    SimConfig cfg;
+    cfg.max_in_flight = 1 << 16;
+    cfg.tape_time_scale = 10000; // 10 us between tape orders
+
+    // Zero latency, one participant: identical to the parameter-sweep backtest.
+    ParticipantConfig solo;
+    solo.quoter = {2, 1, 10};
+    SweepConfig scfg;
+    SweepResult expected = run_single(tape, solo.quoter, scfg);
+    SimResult zero = run_exchange_sim(tape, {solo}, cfg);
+    if (!(zero.participants[0] == expected.summary)) { std::cerr << "zero-latency sim differs from backtest\n"; return 1; }
+    if (expected.summary.fills == 0) { std::cerr << "expected the quoter to trade\n"; return 1; }
+
+    // Many participants at different latencies: deterministic, and latency changes outcomes.
+    std::vector<ParticipantConfig> parts(64);
+    for (size_t i = 0; i < parts.size(); ++i) {
+        parts[i].quoter = {1 + static_cast<int32_t>(i % 4), 1, 10};
+        parts[i].order_entry = {2000 * static_cast<Timestamp>(1 + i / 16), 500, 1000, 50000};
+        parts[i].market_data = {1000 * static_cast<Timestamp>(1 + i / 16), 500, 0, 0};
+    }
+    cfg.matching = {200, 100, 0, 0};
+    SimResult a = run_exchange_sim(tape, parts, cfg);
+    SimResult b = run_exchange_sim(tape, parts, cfg);
+    if (a.stats.dropped != 0 || a.stats.tape_orders != tape.size()) { std::cerr << "sim lost events\n"; return 1; }
+    if (a.stats.events != b.stats.events || a.stats.end_ns != b.stats.end_ns) { std::cerr << "sim not deterministic\n"; return 1; }
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (!(a.participants[i] == b.participants[i])) { std::cerr << "participant results not deterministic\n"; return 1; }
+    }
+    if (a.stats.max_queue_ns <= 0) { std::cerr << "expected queueing at the matching engine\n"; return 1; }
+
+    cfg.seed = 2;
+    SimResult c = run_exchange_sim(tape, parts, cfg);
+    bool differs = false;
+    for (size_t i = 0; i < parts.size(); ++i) differs = differs || !(a.participants[i] == c.participants[i]);
+    if (!differs) { std::cerr << "latency samples had no effect\n"; return 1; }
+
+    std::cout << "test_exchange_sim: PASS\n";
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "exchange/order_book.hpp"
+#include "feed/feed_publisher.hpp"
+#include "feed/feed_subscriber.hpp"
+#include "test_util.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+using namespace nanomarket::feed;
+
+namespace {
+
+struct Session {
+    FeedSubscriber::Stats sub{};
+    FeedPublisher::Stats pub{};
+    bool finished = false;
+    bool book_matches = false;
+    uint64_t published = 0; // sequence numbers used before EndOfSession
+};
+
+// Publish a deterministic order flow the same way MarketDataReplayer does and consume it.
+Session run_session(FeedPublisher::Config pcfg, uint16_t port) {
+    OrderBook::Config cfg{1, 64, 1024, 10000};
+    OrderBook book(cfg);
+
+    pcfg.feed_port = port;
+    pcfg.retransmit_port = static_cast<uint16_t>(port + 1);
+    FeedPublisher pub(pcfg);
+
+    FeedSubscriber::Config scfg;
+    scfg.feed_port = port;
+    scfg.retransmit_port = static_cast<uint16_t>(port + 1);
+    FeedSubscriber sub(scfg);
+    Session s;
+    sub.on_message = [&](uint64_t, const Message& m) {
+        if (m.type == MsgType::EndOfSession) s.published = m.id;
+    };
+    if (!sub.open()) { std::cerr << "cannot open subscriber socket\n"; return s; }
+    if (!pub.start()) { std::cerr << "cannot start publisher\n"; return s; }
+
+    nanomarket::testing::TapeSpec spec;
+    spec.seed = 12345;
+    spec.count = 2000;
+    const std::vector<Order> tape = nanomarket::testing::make_tape(spec);
+
+    OrderBook::TopOfBook final_top;
+    std::thread matcher([&] {
+        OrderBook::TopOfBook last{};
+        Execution out[64];
+        for (const Order& o : tape) {
+            size_t n = book.submit_order(o, out, 64);
+            Qty filled = 0;
+            for (size_t k = 0; k < n; ++k) { pub.on_execution(out[k], o.side); filled += out[k].filled_qty; }
+            if (filled < o.qty) pub.on_add(o, o.qty - filled);
+            auto top = book.top_of_book();
+            if (!(top == last)) { pub.on_top_of_book(top, o.ts); last = top; }
+            if (o.id % 50 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        final_top = book.top_of_book();
+        pub.stop();
+    });
+
+    const int64_t deadline = now_ns() + 10'000'000'000LL;
+    while (sub.poll(10'000) && now_ns() < deadline) {}
+    matcher.join();
+
+    s.sub = sub.stats();
+    s.pub = pub.stats();
+    s.finished = sub.finished();
+    s.book_matches = sub.top_of_book() == final_top;
+    return s;
+}
+
+} // namespace
+
+int main() {
+    // Injected packet loss with a window large enough to recover every gap.
+    {
+        FeedPublisher::Config pcfg;
+        pcfg.drop_every = 3; // force gaps so recovery is exercised
+        const Session s = run_session(pcfg, 39101);
+        if (!s.finished) { std::cerr << "subscriber did not reach EndOfSession\n"; return 1; }
+        if (s.sub.gaps == 0 || s.sub.requests == 0) { std::cerr << "expected injected gaps to be detected\n"; return 1; }
+        if (s.sub.lost != 0) { std::cerr << "expected all gaps to be recovered, lost=" << s.sub.lost << "\n"; return 1; }
+        if (s.sub.top_mismatches != 0) { std::cerr << "shadow book diverged from published top of book\n"; return 1; }
+        if (!s.book_matches) { std::cerr << "rebuilt book does not match matcher book\n"; return 1; }
+        if (s.pub.dropped != 0) { std::cerr << "publisher ring overflowed\n"; return 1; }
+    }
+
+    // A window smaller than one packet: gaps are evicted before they are requested, so the
+    // publisher answers unavailable and the subscriber skips exactly those messages.
+    {
+        FeedPublisher::Config pcfg;
+        pcfg.drop_every = 3;
+        pcfg.retransmit_window = 16;
+        const Session s = run_session(pcfg, 39103);
+        if (!s.finished) { std::cerr << "subscriber did not skip unavailable ranges\n"; return 1; }
+        if (s.sub.lost == 0) { std::cerr << "expected evicted gaps to be reported lost\n"; return 1; }
+        if (s.sub.applied + s.sub.lost != s.published + 1) {
+            std::cerr << "applied " << s.sub.applied << " + lost " << s.sub.lost << " != published " << s.published + 1 << "\n";
+            return 1;
+        }
+    }
+
+    // A ring too small for the burst: drops consume sequence numbers, so the subscriber sees a
+    // gap for each and skips exactly the dropped messages as unavailable.
+    {
+        FeedPublisher::Config pcfg;
+        pcfg.ring_capacity = 16;
+        const Session s = run_session(pcfg, 39105);
+        if (!s.finished) { std::cerr << "subscriber did not get past ring drops\n"; return 1; }
+        if (s.pub.dropped == 0) { std::cerr << "expected a 16-entry ring to overflow\n"; return 1; }
+        if (s.sub.lost != s.pub.dropped) {
+            std::cerr << "lost " << s.sub.lost << " != dropped " << s.pub.dropped << "\n";
+            return 1;
+        }
+        if (s.pub.messages + s.pub.dropped != s.published + 1) {
+            std::cerr << "sequence numbers do not cover sent + dropped messages\n";
+            return 1;
+        }
+    }
+
+    std::cout << "test_feed: PASS\n";
+    return 0;
+}
@@ -39,6 +39,28 @@ int main() {
     if (e2_1 != n2) { std::cerr << "determinism failure: e2_1 != n2\n"; return 1; }
     if (e2_2 != n3) { std::cerr << "determinism failure: e2_2 != n3\n"; return 1; }
 
+    // Rested quantity: the residual of a partial fill, nothing for a full fill, a market order,
+    // or an order that finds the pool full.
+    {
+        OrderBook::Config small{1, 8, 2, 10000};
+        OrderBook b(small);
+        Qty rested = -1;
+        Order s1 = o1;
+        b.submit_order(s1, out, 16, &rested);
+        if (rested != 5) { std::cerr << "expected 5 rested got " << rested << "\n"; return 1; }
+        Order buy = o2; buy.qty = 7; buy.remaining = 7;
+        b.submit_order(buy, out, 16, &rested);
+        if (rested != 2) { std::cerr << "expected residual 2 rested got " << rested << "\n"; return 1; }
+        Order mkt = o3; mkt.price = 0; mkt.side = Side::Sell; mkt.qty = 5; mkt.remaining = 5;
+        b.submit_order(mkt, out, 16, &rested);
+        if (rested != 0) { std::cerr << "market order reported rested " << rested << "\n"; return 1; }
+        Order a = o1; a.id = 10; b.submit_order(a, out, 16, &rested);
+        Order c = o1; c.id = 11; b.submit_order(c, out, 16, &rested);
+        if (rested != 5) { std::cerr << "second resting order not placed\n"; return 1; }
+        Order d = o1; d.id = 12; b.submit_order(d, out, 16, &rested);
+        if (rested != 0) { std::cerr << "full pool reported rested " << rested << "\n"; return 1; }
+    }
+
     std::cout << "test_order_book: PASS\n";
     return 0;
 }
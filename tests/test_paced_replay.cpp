@@ -0,0 +1,97 @@
+#include "core/types.hpp"
+#include "exchange/market_replayer.hpp"
+#include "exchange/order_book.hpp"
+#include "latency/histogram.hpp"
+#include "risk/risk.hpp"
+#include "test_util.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+
+static bool histogram_within_bounds() {
+    nanomarket::latency::Histogram h;
+    std::vector<int64_t> v;
+    nanomarket::testing::Lcg rng{5};
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t x = rng.next();
+        const int64_t s = static_cast<int64_t>((x >> 33) % (1u << ((x >> 20) % 28)));
+        h.record(s);
+        v.push_back(s);
+    }
+    std::sort(v.begin(), v.end());
+    for (double p : {1.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        size_t rank = static_cast<size_t>(p / 100.0 * v.size() + 0.999999);
+        const int64_t exact = v[std::max<size_t>(rank, 1) - 1];
+        const int64_t got = h.percentile(p);
+        if (got < exact || got > exact + exact / 16 + 1) return false;
+    }
+    return h.count() == v.size() && h.max() == v.back() && h.min() == v.front();
+}
+
+static int replay(const char* infile, const char* outfile, double speed, MarketDataReplayer::PacedStats* stats) {
+    OrderBook book(OrderBook::Config{1, 64, 1024, 10000});
+    nanomarket::risk::RiskEngine risk;
+    risk.limits().max_position = 1000000;
+    risk.limits().max_notional = 1LL << 40;
+    MarketDataReplayer::Config rcfg;
+    rcfg.infile = infile;
+    rcfg.outfile = outfile;
+    rcfg.speed = speed;
+    MarketDataReplayer r(rcfg, book, risk);
+    const int rc = r.run();
+    if (stats) *stats = r.paced_stats();
+    return rc;
+}
+
+int main() {
+    if (!histogram_within_bounds()) { std::cerr << "histogram percentiles out of bounds\n"; return 1; }
+
+    // 200 events spaced 1 ms apart, then a burst of 3000 events sharing one timestamp.
+    const char* infile = "test_paced_input.csv";
+    FILE* f = nullptr;
+    if (fopen_s(&f, infile, "w") != 0 || !f) { std::cerr << "cannot write tape\n"; return 1; }
+    int id = 0;
+    for (int i = 0; i < 200; ++i)
+        std::fprintf(f, "ORDER,%d,%c,%d,1,%lld\n", ++id, (i & 1) ? 'B' : 'S', 10000 + i % 3, 1'000'000LL * i);
+    for (int i = 0; i < 3000; ++i)
+        std::fprintf(f, "ORDER,%d,%c,%d,1,%lld\n", ++id, (i & 1) ? 'B' : 'S', 10000 + i % 3, 200'000'000LL);
+    std::fclose(f);
+
+    if (replay(infile, "test_paced_fast.log", 0.0, nullptr) != 0) { std::cerr << "unpaced replay failed\n"; return 1; }
+
+    MarketDataReplayer::PacedStats s;
+    const int64_t t0 = now_ns();
+    if (replay(infile, "test_paced_paced.log", 2.0, &s) != 0) { std::cerr << "paced replay failed\n"; return 1; }
+    const int64_t elapsed = now_ns() - t0;
+
+    if (nanomarket::testing::slurp("test_paced_fast.log") != nanomarket::testing::slurp("test_paced_paced.log")) {
+        std::cerr << "pacing changed the output\n";
+        return 1;
+    }
+    // 200 ms of tape at speed 2 takes at least 100 ms.
+    if (elapsed < 100'000'000 || s.wall_ns < 100'000'000) { std::cerr << "events released early\n"; return 1; }
+    if (s.latency.count() != static_cast<uint64_t>(id) || s.service.count() != static_cast<uint64_t>(id)) {
+        std::cerr << "expected one sample per event\n";
+        return 1;
+    }
+    uint64_t total = 0;
+    for (uint64_t n : s.per_second) total += n;
+    if (total != static_cast<uint64_t>(id)) { std::cerr << "per-second throughput does not add up\n"; return 1; }
+
+    // The burst queues: the last event waits for all 2999 before it, which the corrected latency
+    // must show even though each event's own service time stays small.
+    if (s.latency.max() < 100 * s.service.percentile(50) || s.latency.max() < s.max_lag_ns) {
+        std::cerr << "queueing delay missing from latency (max " << s.latency.max() << " ns, service p50 "
+                  << s.service.percentile(50) << " ns)\n";
+        return 1;
+    }
+
+    std::cout << "test_paced_replay: PASS\n";
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "backtest/param_sweep.hpp"
+#include "test_util.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace nanomarket::backtest;
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+
+int main() {
+    // Deterministic synthetic tape around the book reference price.
+    nanomarket::testing::TapeSpec spec;
+    spec.count = 20000;
+    const std::vector<Order> tape = nanomarket::testing::make_tape(spec);
+
+    auto grid = make_grid({1, 2, 5}, {1, 3}, {5, 20});
+    SweepConfig cfg;
+    cfg.threads = 3;
+    cfg.batch_events = 64;
+    auto results = run_sweep(tape, grid, cfg);
+    if (results.size() != grid.size()) { std::cerr << "expected one result per configuration\n"; return 1; }
+
+    // Each configuration must match running it alone.
+    bool any_fills = false;
+    for (size_t k = 0; k < grid.size(); ++k) {
+        SweepResult alone = run_single(tape, grid[k], cfg);
+        if (!(alone.summary == results[k].summary)) {
+            std::cerr << "sweep result " << k << " differs from single run\n";
+            return 1;
+        }
+        if (results[k].settings.spread_ticks != grid[k].spread_ticks) { std::cerr << "results out of grid order\n"; return 1; }
+        any_fills = any_fills || results[k].summary.fills > 0;
+    }
+    if (!any_fills) { std::cerr << "expected the quoter to trade\n"; return 1; }
+
+    // Different thread counts and batch sizes must not change results.
+    cfg.threads = 1;
+    cfg.batch_events = 1000;
+    auto again = run_sweep(tape, grid, cfg);
+    for (size_t k = 0; k < grid.size(); ++k) {
+        if (!(again[k].summary == results[k].summary)) { std::cerr << "sweep not deterministic\n"; return 1; }
+    }
+
+    std::cout << "test_param_sweep: PASS\n";
+    return 0;
+}
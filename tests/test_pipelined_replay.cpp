@@ -0,0 +1,77 @@
+#include "exchange/market_replayer.hpp"
+#include "exchange/order_book.hpp"
+#include "exchange/pipelined_replayer.hpp"
+#include "exchange/replay_digest.hpp"
+#include "risk/risk.hpp"
+#include "test_util.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+
+int main() {
+    // Tape long enough to span many batches, with rejects (small risk limits) and missing ts columns.
+    const char* infile = "test_pipelined_input.csv";
+    nanomarket::testing::TapeSpec spec;
+    spec.seed = 99;
+    spec.count = 50000;
+    spec.price_lo = 9980;
+    spec.price_span = 41;
+    spec.max_qty = 9;
+    std::vector<Order> tape = nanomarket::testing::make_tape(spec);
+    for (Order& o : tape) o.ts *= 3;
+    if (!nanomarket::testing::write_tape_csv(infile, tape, 7, 1000)) { std::cerr << "cannot write tape\n"; return 1; }
+
+    auto make_risk = [](nanomarket::risk::RiskEngine& r) {
+        r.limits().max_position = 40;
+        r.limits().max_notional = 1LL << 40;
+    };
+    OrderBook::Config cfg{1, 64, 1024, 10000};
+
+    ReplayDigest serial_digest(1000);
+    {
+        OrderBook book(cfg);
+        nanomarket::risk::RiskEngine risk;
+        make_risk(risk);
+        MarketDataReplayer::Config rcfg;
+        rcfg.infile = infile;
+        rcfg.outfile = "test_pipelined_serial.log";
+        rcfg.digest = &serial_digest;
+        MarketDataReplayer replayer(rcfg, book, risk);
+        if (replayer.run() != 0) { std::cerr << "serial replay failed\n"; return 1; }
+    }
+
+    ReplayDigest piped_digest(1000);
+    PipelinedReplayer::Stats stats;
+    {
+        OrderBook book(cfg);
+        nanomarket::risk::RiskEngine risk;
+        make_risk(risk);
+        PipelinedReplayer::Config pcfg;
+        pcfg.infile = infile;
+        pcfg.outfile = "test_pipelined_piped.log";
+        pcfg.digest = &piped_digest;
+        PipelinedReplayer replayer(pcfg, book, risk);
+        if (replayer.run() != 0) { std::cerr << "pipelined replay failed\n"; return 1; }
+        stats = replayer.stats();
+    }
+
+    std::string a = nanomarket::testing::slurp("test_pipelined_serial.log");
+    std::string b = nanomarket::testing::slurp("test_pipelined_piped.log");
+    if (a.empty() || a != b) { std::cerr << "pipelined output differs from serial output\n"; return 1; }
+    if (a.find("REJECTED") == std::string::npos) { std::cerr << "expected the tape to exercise rejects\n"; return 1; }
+    if (ReplayDigest::compare(serial_digest.checkpoints(), piped_digest.checkpoints()).diverged) {
+        std::cerr << "pipelined digest differs\n";
+        return 1;
+    }
+    if (stats.decode.events != 50000 || stats.match.events != 50000 || stats.output.events != 50000) {
+        std::cerr << "stage event counts wrong\n";
+        return 1;
+    }
+
+    std::cout << "test_pipelined_replay: PASS\n";
+    return 0;
+}
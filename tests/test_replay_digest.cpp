@@ -0,0 +1,75 @@
+#include "exchange/market_replayer.hpp"
+#include "exchange/order_book.hpp"
+#include "exchange/replay_digest.hpp"
+#include "risk/risk.hpp"
+#include "test_util.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+
+// Write a deterministic tape; `perturb_id` gets a different quantity.
+static bool write_tape(const char* path, int n, int perturb_id) {
+    nanomarket::testing::TapeSpec spec;
+    spec.seed = 7;
+    spec.count = n;
+    std::vector<Order> tape = nanomarket::testing::make_tape(spec);
+    if (perturb_id >= 1 && perturb_id <= n) tape[perturb_id - 1].qty += 1;
+    return nanomarket::testing::write_tape_csv(path, tape);
+}
+
+static ReplayDigest run(const char* infile, const char* outfile, uint64_t interval) {
+    OrderBook::Config cfg{1, 64, 1024, 10000};
+    OrderBook book(cfg);
+    nanomarket::risk::RiskEngine risk;
+    risk.limits().max_notional = 1LL << 60; // keep trading through the whole tape
+    risk.limits().max_position = 1LL << 40;
+    ReplayDigest digest(interval);
+    MarketDataReplayer::Config rcfg;
+    rcfg.infile = infile;
+    rcfg.outfile = outfile;
+    rcfg.digest = &digest;
+    MarketDataReplayer replayer(rcfg, book, risk);
+    if (replayer.run() != 0) std::cerr << "replay failed\n";
+    return digest;
+}
+
+int main() {
+    const char* base = "test_replay_digest_base.csv";
+    const char* changed = "test_replay_digest_changed.csv";
+    if (!write_tape(base, 10000, 0) || !write_tape(changed, 10000, 5000)) { std::cerr << "cannot write tapes\n"; return 1; }
+
+    // The digest does not depend on whether the text log is written.
+    ReplayDigest a = run(base, "test_replay_digest.log", 256);
+    ReplayDigest b = run(base, nullptr, 256);
+    if (a.events() != 10000 || a.checkpoints().size() != (10000 + 255) / 256) { std::cerr << "unexpected checkpoint count\n"; return 1; }
+    if (ReplayDigest::compare(a.checkpoints(), b.checkpoints()).diverged) { std::cerr << "identical runs diverged\n"; return 1; }
+
+    // A change at order 5000 (event index 4999) is located to its 256-event segment.
+    ReplayDigest c = run(changed, nullptr, 256);
+    auto d = ReplayDigest::compare(a.checkpoints(), c.checkpoints());
+    if (!d.diverged || d.first_event != 4864 || d.end_event != 5120) {
+        std::cerr << "expected divergence in [4864, 5120), got [" << d.first_event << ", " << d.end_event << ")\n";
+        return 1;
+    }
+
+    // A truncated run diverges where it stops.
+    std::vector<ReplayDigest::Checkpoint> shorter(a.checkpoints().begin(), a.checkpoints().begin() + 10);
+    d = ReplayDigest::compare(a.checkpoints(), shorter);
+    if (!d.diverged || d.first_event != 2560 || d.end_event != 10000) { std::cerr << "truncation not detected\n"; return 1; }
+
+    // Golden-file round trip.
+    if (!a.save("test_replay_digest.digest")) { std::cerr << "cannot save digest\n"; return 1; }
+    uint64_t interval = 0;
+    std::vector<ReplayDigest::Checkpoint> loaded;
+    if (!ReplayDigest::load("test_replay_digest.digest", interval, loaded) || interval != 256 || loaded != a.checkpoints()) {
+        std::cerr << "digest file round trip failed\n";
+        return 1;
+    }
+
+    std::cout << "test_replay_digest: PASS\n";
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "exchange/market_snapshot.hpp"
+#include "exchange/order_book.hpp"
+#include "risk/risk.hpp"
+#include "utils/seqlock.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+
+// Payload whose fields must always agree; a torn read breaks the invariants.
+struct Payload {
+    int64_t a;
+    int64_t neg_a;
+    int64_t words[24];
+};
+
+int main() {
+    nanomarket::utils::SeqLock<Payload> lock;
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    const int64_t writes = 200000;
+
+    std::vector<std::thread> readers;
+    std::vector<int64_t> last_seen(3, 0);
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r] {
+            while (!done.load(std::memory_order_acquire)) {
+                Payload p = lock.load();
+                bool ok = p.neg_a == -p.a && p.a >= last_seen[r];
+                for (int64_t w : p.words) ok = ok && w == p.a * 3;
+                if (!ok) torn.store(true);
+                last_seen[r] = p.a;
+            }
+        });
+    }
+    for (int64_t i = 1; i <= writes; ++i) {
+        Payload p;
+        p.a = i;
+        p.neg_a = -i;
+        for (auto& w : p.words) w = i * 3;
+        lock.store(p);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+    if (torn.load()) { std::cerr << "reader observed a torn or stale-ordered snapshot\n"; return 1; }
+    if (lock.version() != static_cast<uint64_t>(writes)) { std::cerr << "unexpected version\n"; return 1; }
+    if (lock.load().a != writes) { std::cerr << "final value not visible\n"; return 1; }
+
+    // Book/risk snapshot contents.
+    OrderBook::Config cfg{1, 64, 1024, 10000};
+    OrderBook book(cfg);
+    nanomarket::risk::RiskEngine risk;
+    SnapshotPublisher pub;
+    Execution out[16];
+    auto submit = [&](OrderId id, Side side, Price px, Qty qty) {
+        Order o; o.id = id; o.side = side; o.price = px; o.qty = qty; o.remaining = qty; o.ts = static_cast<Timestamp>(id);
+        size_t n = book.submit_order(o, out, 16);
+        for (size_t i = 0; i < n; ++i) { risk.on_fill(out[i].price, out[i].filled_qty, side); pub.on_execution(out[i]); }
+    };
+    submit(1, Side::Buy, 9998, 4);
+    submit(2, Side::Buy, 9999, 2);
+    submit(3, Side::Sell, 10003, 3); // trades against the resting bids
+    submit(4, Side::Sell, 10001, 2);
+    submit(5, Side::Sell, 10002, 1);
+    submit(6, Side::Buy, 9995, 7);
+    pub.publish(book, risk, 6);
+
+    MarketSnapshot s = pub.read();
+    auto top = book.top_of_book();
+    if (s.batch != 1 || s.ts != 6) { std::cerr << "bad snapshot header\n"; return 1; }
+    if ((s.bid_levels > 0) != (top.bid_qty > 0) || (s.ask_levels > 0) != (top.ask_qty > 0)) { std::cerr << "depth/top mismatch\n"; return 1; }
+    if (s.bid_levels > 0 && (s.bids[0].px != top.bid_px || s.bids[0].qty != top.bid_qty)) { std::cerr << "best bid mismatch\n"; return 1; }
+    if (s.ask_levels > 0 && (s.asks[0].px != top.ask_px || s.asks[0].qty != top.ask_qty)) { std::cerr << "best ask mismatch\n"; return 1; }
+    for (uint32_t i = 1; i < s.bid_levels; ++i) if (s.bids[i].px >= s.bids[i - 1].px) { std::cerr << "bids not best-first\n"; return 1; }
+    for (uint32_t i = 1; i < s.ask_levels; ++i) if (s.asks[i].px <= s.asks[i - 1].px) { std::cerr << "asks not best-first\n"; return 1; }
+    if (s.position != risk.position() || s.notional != risk.notional()) { std::cerr << "risk state mismatch\n"; return 1; }
+    if (s.last_trade_qty == 0) { std::cerr << "expected a last trade\n"; return 1; }
+
+    std::cout << "test_seqlock: PASS\n";
+    return 0;
+}
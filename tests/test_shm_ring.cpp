@@ -0,0 +1,116 @@
+#include "exchange/order.hpp"
+#include "utils/shm_ring.hpp"
+
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace nanomarket::exchange;
+using namespace nanomarket::utils;
+
+int main() {
+    using Ring = ShmSpscRing<Order, 1024>;
+    const char* name = "nanomarket_test_shm_ring";
+
+    // Matcher side creates the segment as consumer; a "strategy" maps it separately as producer.
+    auto consumer = std::make_unique<Ring>();
+    auto producer = std::make_unique<Ring>();
+    if (!consumer->create(name, Ring::Role::Consumer)) { std::cerr << "create failed\n"; return 1; }
+    if (consumer->peer_attached()) { std::cerr << "no producer should be attached yet\n"; return 1; }
+    if (!producer->attach(name, Ring::Role::Producer)) { std::cerr << "attach failed\n"; return 1; }
+    if (!consumer->peer_alive(1'000'000'000)) { std::cerr << "producer should be alive\n"; return 1; }
+
+    // A live ring is never replaced by a second create under the same name.
+    auto rival = std::make_unique<Ring>();
+    if (rival->create(name, Ring::Role::Consumer)) { std::cerr << "create replaced a live ring\n"; return 1; }
+
+    // A layout mismatch is rejected.
+    auto wrong = std::make_unique<ShmSpscRing<Order, 512>>();
+    if (wrong->attach(name, ShmSpscRing<Order, 512>::Role::Producer)) { std::cerr << "capacity mismatch accepted\n"; return 1; }
+
+    // Cross-mapping transfer preserves order and content.
+    const int total = 100000;
+    std::thread prod([&] {
+        for (int i = 1; i <= total; ++i) {
+            Order o;
+            o.id = static_cast<nanomarket::core::OrderId>(i);
+            o.price = 10000 + (i % 7);
+            o.qty = i % 5 + 1;
+            while (!producer->push(o)) std::this_thread::yield();
+        }
+    });
+    int expected = 1;
+    while (expected <= total) {
+        Order o;
+        if (!consumer->pop(o)) continue;
+        if (o.id != static_cast<nanomarket::core::OrderId>(expected) || o.price != 10000 + (expected % 7)) {
+            std::cerr << "out of order or corrupt element at " << expected << "\n";
+            prod.join();
+            return 1;
+        }
+        ++expected;
+    }
+    prod.join();
+    if (!consumer->empty()) { std::cerr << "ring should be empty\n"; return 1; }
+
+    // Detach is visible to the peer.
+    producer->detach();
+    if (consumer->peer_attached() || consumer->peer_alive(0)) { std::cerr << "detach not observed\n"; return 1; }
+
+#if !defined(_WIN32)
+    // A strategy process that dies without detaching: the matcher sees it go, and a replacement
+    // takes over the producer role and continues the stream.
+    {
+        const pid_t child = fork();
+        if (child == 0) {
+            Ring p;
+            if (!p.attach(name, Ring::Role::Producer)) _exit(2);
+            Order o;
+            o.id = 1;
+            _exit(p.push(o) ? 0 : 3); // no detach: as if it crashed
+        }
+        int status = 0;
+        if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "forked producer failed\n";
+            return 1;
+        }
+        if (!consumer->peer_attached()) { std::cerr << "crashed producer should still hold its role\n"; return 1; }
+        if (consumer->peer_alive(1'000'000'000)) { std::cerr << "dead producer reported alive\n"; return 1; }
+        Order o;
+        if (!consumer->pop(o) || o.id != 1) { std::cerr << "element from dead producer lost\n"; return 1; }
+
+        auto replacement = std::make_unique<Ring>();
+        if (!replacement->attach(name, Ring::Role::Producer)) { std::cerr << "takeover of dead producer failed\n"; return 1; }
+        if (!consumer->peer_alive(1'000'000'000)) { std::cerr << "replacement producer not seen\n"; return 1; }
+        o.id = 2;
+        if (!replacement->push(o) || !consumer->pop(o) || o.id != 2) { std::cerr << "ring broken after takeover\n"; return 1; }
+        replacement->detach();
+    }
+
+    // A creator that dies leaves its segment behind; the next create reclaims it.
+    {
+        const char* orphan = "nanomarket_test_shm_orphan";
+        const pid_t child = fork();
+        if (child == 0) {
+            Ring r;
+            _exit(r.create(orphan, Ring::Role::Consumer) ? 0 : 2); // exits without detaching
+        }
+        int status = 0;
+        if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "forked creator failed\n";
+            return 1;
+        }
+        auto fresh = std::make_unique<Ring>();
+        if (!fresh->create(orphan, Ring::Role::Consumer)) { std::cerr << "stale segment not reclaimed\n"; return 1; }
+        if (fresh->peer_attached()) { std::cerr << "reclaimed segment kept stale state\n"; return 1; }
+    }
+#endif
+
+    std::cout << "test_shm_ring: PASS\n";
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "exchange/order_book.hpp"
+#include "risk/risk.hpp"
+#include "test_util.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+using namespace nanomarket::exchange;
+using namespace nanomarket::core;
+
+namespace {
+
+struct Outcome {
+    std::vector<Execution> execs;
+    std::vector<uint8_t> accepted;
+    int64_t position = 0;
+    int64_t notional = 0;
+    OrderBook::TopOfBook top;
+    std::vector<OrderBook::DepthLevel> bids, asks;
+};
+
+const OrderBook::Config kCfg{1, 64, 1024, 10000};
+
+void set_limits(nanomarket::risk::RiskEngine& risk) {
+    risk.limits().max_position = 60;
+    risk.limits().max_order_size = 8;
+    risk.limits().max_notional = 1LL << 40;
+}
+
+void finish(const OrderBook& book, const nanomarket::risk::RiskEngine& risk, Outcome& out) {
+    out.position = risk.position();
+    out.notional = risk.notional();
+    out.top = book.top_of_book();
+    out.bids.resize(64);
+    out.asks.resize(64);
+    out.bids.resize(book.depth(Side::Buy, out.bids.data(), out.bids.size()));
+    out.asks.resize(book.depth(Side::Sell, out.asks.data(), out.asks.size()));
+}
+
+Outcome run_sequential(const std::vector<Order>& tape) {
+    Outcome out;
+    OrderBook book(kCfg);
+    nanomarket::risk::RiskEngine risk;
+    set_limits(risk);
+    Execution buf[OrderBook::kBatchMaxExecs];
+    for (const Order& o : tape) {
+        const bool ok = risk.check_new_order(o.price, o.qty, o.side);
+        out.accepted.push_back(ok);
+        if (!ok) continue;
+        const size_t n = std::min(book.submit_order(o, buf, OrderBook::kBatchMaxExecs), OrderBook::kBatchMaxExecs);
+        for (size_t i = 0; i < n; ++i) {
+            risk.on_fill(buf[i].price, buf[i].filled_qty, o.side);
+            out.execs.push_back(buf[i]);
+        }
+    }
+    finish(book, risk, out);
+    return out;
+}
+
+Outcome run_batched(const std::vector<Order>& tape, size_t batch) {
+    Outcome out;
+    OrderBook book(kCfg);
+    nanomarket::risk::RiskEngine risk;
+    set_limits(risk);
+    nanomarket::risk::BatchTerms terms;
+    for (size_t base = 0; base < tape.size(); base += batch) {
+        const size_t n = std::min(batch, tape.size() - base);
+        const std::span<const Order> orders(tape.data() + base, n);
+        if (risk.prepare_batch(orders, terms) != n) return Outcome{};
+        book.submit_batch(
+            orders, [&](size_t i, const Order&) { return risk.check_prepared(terms, i); },
+            [&](size_t, const Order& o, bool accepted, const Execution* execs, size_t m) {
+                out.accepted.push_back(accepted);
+                for (size_t i = 0; i < m; ++i) {
+                    risk.on_fill(execs[i].price, execs[i].filled_qty, o.side);
+                    out.execs.push_back(execs[i]);
+                }
+            });
+    }
+    finish(book, risk, out);
+    return out;
+}
+
+bool same(const Outcome& a, const Outcome& b) {
+    if (a.execs.size() != b.execs.size() || a.accepted != b.accepted) return false;
+    for (size_t i = 0; i < a.execs.size(); ++i) {
+        const Execution& x = a.execs[i];
+        const Execution& y = b.execs[i];
+        if (x.resting_id != y.resting_id || x.incoming_id != y.incoming_id || x.filled_qty != y.filled_qty ||
+            x.price != y.price || x.ts != y.ts)
+            return false;
+    }
+    if (a.bids.size() != b.bids.size() || a.asks.size() != b.asks.size()) return false;
+    for (size_t i = 0; i < a.bids.size(); ++i)
+        if (a.bids[i].px != b.bids[i].px || a.bids[i].qty != b.bids[i].qty || a.bids[i].orders != b.bids[i].orders) return false;
+    for (size_t i = 0; i < a.asks.size(); ++i)
+        if (a.asks[i].px != b.asks[i].px || a.asks[i].qty != b.asks[i].qty || a.asks[i].orders != b.asks[i].orders) return false;
+    return a.position == b.position && a.notional == b.notional && a.top == b.top;
+}
+
+} // namespace
+
+int main() {
+    // Limit and market orders, prices beyond both ladder edges, sizes over the risk limit, and
+    // large orders that sweep many resting orders.
+    nanomarket::testing::TapeSpec spec;
+    spec.seed = 2024;
+    spec.count = 20000;
+    spec.price_lo = 9940;
+    spec.price_span = 121;
+    spec.max_qty = 9;
+    spec.market_every = 97;
+    spec.large_every = 13;
+    spec.large_qty = 40;
+    const std::vector<Order> tape = nanomarket::testing::make_tape(spec);
+
+    const Outcome expected = run_sequential(tape);
+    const bool rejects = std::find(expected.accepted.begin(), expected.accepted.end(), 0) != expected.accepted.end();
+    if (expected.execs.empty() || !rejects) { std::cerr << "tape should trade and hit risk limits\n"; return 1; }
+
+    for (size_t batch : {1, 2, 5, 64, 255, 256}) {
+        if (!same(expected, run_batched(tape, batch))) {
+            std::cerr << "submit_batch with batch size " << batch << " differs from sequential submission\n";
+            return 1;
+        }
+    }
+
+    // submit_batch alone accepts spans longer than its internal chunk, and reports executions
+    // up to its MaxExecs exactly as submit_order does up to max_out.
+    {
+        OrderBook seq(kCfg), bat(kCfg);
+        constexpr size_t kCap = 3;
+        Execution buf[kCap];
+        std::vector<Execution> a, b;
+        bool truncated = false;
+        for (const Order& o : tape) {
+            const size_t produced = seq.submit_order(o, buf, kCap);
+            truncated = truncated || produced > kCap;
+            a.insert(a.end(), buf, buf + std::min(produced, kCap));
+        }
+        if (!truncated) {
+            std::cerr << "tape never exceeds the execution cap\n";
+            return 1;
+        }
+        const size_t admitted = bat.submit_batch<kCap>(
+            std::span<const Order>(tape), [](size_t, const Order&) { return true; },
+            [&](size_t, const Order&, bool, const Execution* e, size_t n) { b.insert(b.end(), e, e + n); });
+        if (admitted != tape.size() || a.size() != b.size() || !(seq.top_of_book() == bat.top_of_book())) {
+            std::cerr << "unchunked submit_batch differs from sequential submission\n";
+            return 1;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].resting_id != b[i].resting_id || a[i].filled_qty != b[i].filled_qty || a[i].ts != b[i].ts) {
+                std::cerr << "unchunked submit_batch executions differ\n";
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "test_submit_batch: PASS\n";
+    return 0;
+}
@@ -0,0 +1,86 @@
+// tests/test_util.hpp
+#pragma once
+
+#include "core/types.hpp"
+#include "exchange/order.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Helpers shared by the standalone tests: the deterministic synthetic order tape, its CSV form
+// and whole-file reads. Header-only, so it never becomes a test target of its own.
+
+namespace nanomarket::testing {
+
+// 64-bit LCG (Knuth's MMIX constants). Integer-only, so every platform sees the same stream.
+struct Lcg {
+    uint64_t x;
+    uint64_t next() noexcept { return x = x * 6364136223846793005ULL + 1442695040888963407ULL; }
+};
+
+// Shape of a synthetic tape. Order i (1-based) takes one LCG step: side from bit 33, price
+// price_lo + (bits 40.. mod price_span), qty 1 + (bits 50.. mod max_qty); id = ts = i.
+struct TapeSpec {
+    uint64_t seed = 42;
+    int count = 1000;
+    core::Price price_lo = 9990;
+    uint64_t price_span = 21;
+    uint64_t max_qty = 5;
+    int market_every = 0; // every Nth order is a market order (price 0); 0 = none
+    int large_every = 0;  // every Nth order draws its qty up to large_qty instead; 0 = none
+    uint64_t large_qty = 0;
+};
+
+inline std::vector<exchange::Order> make_tape(const TapeSpec& spec) {
+    std::vector<exchange::Order> tape;
+    tape.reserve(static_cast<size_t>(spec.count));
+    Lcg rng{spec.seed};
+    for (int i = 1; i <= spec.count; ++i) {
+        const uint64_t x = rng.next();
+        const bool large = spec.large_every != 0 && i % spec.large_every == 0;
+        exchange::Order o;
+        o.id = static_cast<core::OrderId>(i);
+        o.side = ((x >> 33) & 1) ? core::Side::Buy : core::Side::Sell;
+        o.price = (spec.market_every != 0 && i % spec.market_every == 0)
+                      ? 0
+                      : spec.price_lo + static_cast<core::Price>((x >> 40) % spec.price_span);
+        o.qty = 1 + static_cast<core::Qty>((x >> 50) % (large ? spec.large_qty : spec.max_qty));
+        o.remaining = o.qty;
+        o.ts = i;
+        tape.push_back(o);
+    }
+    return tape;
+}
+
+// Write `tape` in the replay CSV format. The ts column is left out on every `omit_ts_every`th
+// line and a comment line follows every `comment_every`th order (0 = never), to exercise the
+// decoder's logical timestamps and skipping.
+inline bool write_tape_csv(const char* path, const std::vector<exchange::Order>& tape, int omit_ts_every = 0,
+                           int comment_every = 0) {
+    FILE* f = nullptr;
+    if (fopen_s(&f, path, "w") != 0 || !f) return false;
+    for (size_t i = 0; i < tape.size(); ++i) {
+        const exchange::Order& o = tape[i];
+        const int n = static_cast<int>(i + 1);
+        const char side = o.side == core::Side::Buy ? 'B' : 'S';
+        if (omit_ts_every != 0 && n % omit_ts_every == 0)
+            std::fprintf(f, "ORDER,%llu,%c,%lld,%d\n", (unsigned long long)o.id, side, (long long)o.price, (int)o.qty);
+        else
+            std::fprintf(f, "ORDER,%llu,%c,%lld,%d,%lld\n", (unsigned long long)o.id, side, (long long)o.price,
+                         (int)o.qty, (long long)o.ts);
+        if (comment_every != 0 && n % comment_every == 0) std::fprintf(f, "# comment line\n");
+    }
+    std::fclose(f);
+    return true;
+}
+
+inline std::string slurp(const char* path) {
+    std::ifstream f(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+} // namespace nanomarket::testing